@@ -1,8 +1,12 @@
 #pragma once
 
+#include "clap/audio-buffer.h"
 #include "clap/plugin.h"
 #include "clap/stream.h"
 
+#include <algorithm>
+#include <array>
+#include <cstring>
 #include <string>
 #include <vector>
 
@@ -15,7 +19,7 @@ struct ClapPluginMethodHelper;
 
 // Returns a plain-C function which calls a given C++ method
 template<auto methodPtr>
-auto pluginMethod() {
+constexpr auto pluginMethod() {
 	using C = ClapPluginMethodHelper<decltype(methodPtr)>;
 	return C::template callMethod<methodPtr>;
 }
@@ -39,22 +43,34 @@ bool getHostExtension(const clap_host *host, const char *extId, const HostExtens
 	return hostExt;
 }
 
+// ---- `data32` or `data64`, for processing templated on the sample type ----
+
+template<class Sample>
+Sample ** bufferChannels(const clap_audio_buffer &buffer);
+template<>
+inline float ** bufferChannels<float>(const clap_audio_buffer &buffer) {
+	return buffer.data32;
+}
+template<>
+inline double ** bufferChannels<double>(const clap_audio_buffer &buffer) {
+	return buffer.data64;
+}
+
 // ---- read/write strings or byte-vectors using CLAP stream(s) ----
 
+// Appends the whole stream to the container, growing it geometrically.  Any spare capacity (e.g. from `.reserve()`) is used first.
 template<class Container>
 bool readAllFromStream(Container &byteContainer, const clap_istream *istream, size_t chunkBytes=1024) {
+	size_t index = byteContainer.size();
+	byteContainer.resize(std::max<size_t>(index + std::max<size_t>(chunkBytes, 1), byteContainer.capacity()));
 	while (1) {
-		size_t index = byteContainer.size();
-		byteContainer.resize(index + chunkBytes);
-		int64_t result = istream->read(istream, (void *)&byteContainer[index], uint64_t(chunkBytes));
-		if (result == chunkBytes) {
-			continue;
-		} else if (result >= 0) {
-			byteContainer.resize(index + result);
-			if (result == 0) return true;
-		} else {
-			return false;
+		if (index == byteContainer.size()) byteContainer.resize(index*2);
+		int64_t result = istream->read(istream, (void *)&byteContainer[index], uint64_t(byteContainer.size() - index));
+		if (result <= 0) {
+			byteContainer.resize(index);
+			return result == 0;
 		}
+		index += size_t(result);
 	}
 }
 
@@ -73,4 +89,103 @@ bool writeAllToStream(const Container &c, const clap_ostream *ostream) {
 	return writeAllToStream((const void *)c.data(), c.size()*sizeof(c[0]), ostream);
 }
 
+/* Writes to a `clap_ostream` through a small fixed-size window, so you don't need to build the whole thing in memory first.
+
+Any error is sticky, and reported by `.flush()`, which you must call at the end.
+*/
+template<size_t windowBytes=256>
+struct StreamWriter {
+	StreamWriter(const clap_ostream *ostream) : ostream(ostream) {}
+
+	bool write(const void *data, size_t length) {
+		auto *bytes = (const unsigned char *)data;
+		if (length >= windowBytes) { // big enough to skip the window
+			return flush() && (ok = writeAllToStream(bytes, length, ostream));
+		}
+		if (used + length > windowBytes && !flush()) return false;
+		std::memcpy(window.data() + used, bytes, length);
+		used += length;
+		return ok;
+	}
+	bool writeByte(unsigned char byte) {
+		if (used >= windowBytes && !flush()) return false;
+		window[used++] = byte;
+		return ok;
+	}
+	bool flush() {
+		if (ok && used) ok = writeAllToStream(window.data(), used, ostream);
+		used = 0;
+		return ok;
+	}
+private:
+	const clap_ostream *ostream;
+	std::array<unsigned char, windowBytes> window;
+	size_t used = 0;
+	bool ok = true;
+};
+
+// Reads from a `clap_istream` through a small fixed-size window
+template<size_t windowBytes=256>
+struct StreamReader {
+	StreamReader(const clap_istream *istream) : istream(istream) {}
+	
+	// Returns the number of bytes read, which is only short at the end of the stream (or on error)
+	size_t read(void *data, size_t length) {
+		auto *bytes = (unsigned char *)data;
+		size_t done = 0;
+		while (done < length) {
+			if (start == end) {
+				if (length - done >= windowBytes) { // read directly
+					int64_t result = istream->read(istream, bytes + done, uint64_t(length - done));
+					if (result <= 0) {
+						failed = (result < 0);
+						break;
+					}
+					done += size_t(result);
+					continue;
+				}
+				if (!fill()) break;
+			}
+			size_t n = std::min(length - done, end - start);
+			std::memcpy(bytes + done, window.data() + start, n);
+			start += n;
+			done += n;
+		}
+		return done;
+	}
+	bool readByte(unsigned char &byte) {
+		if (start == end && !fill()) return false;
+		byte = window[start++];
+		return true;
+	}
+	// Appends everything remaining (including anything in the window) to a container
+	template<class Container>
+	bool readRest(Container &byteContainer) {
+		if (end > start) {
+			size_t index = byteContainer.size();
+			byteContainer.resize(index + (end - start));
+			std::memcpy((void *)&byteContainer[index], window.data() + start, end - start);
+		}
+		start = end = 0;
+		return !failed && readAllFromStream(byteContainer, istream);
+	}
+
+	bool error() const {
+		return failed;
+	}
+private:
+	const clap_istream *istream;
+	std::array<unsigned char, windowBytes> window;
+	size_t start = 0, end = 0;
+	bool failed = false;
+	
+	bool fill() {
+		int64_t result = istream->read(istream, window.data(), uint64_t(windowBytes));
+		failed = (result < 0);
+		start = 0;
+		end = (result > 0) ? size_t(result) : 0;
+		return end > 0;
+	}
+};
+
 }} // namespace
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstddef>
+
+namespace signalsmith { namespace clap {
+
+/* A file compiled into the binary (see `source/hxx-resources.py`).
+
+These live in constant tables, so they can be served directly from the data without copying.
+*/
+struct EmbeddedResource {
+	const char *path; // relative to the resource directory
+	const char *mediaType;
+	const unsigned char *data;
+	size_t size;
+};
+
+// Ignores leading slashes, and directories (or an empty path) match their `index.html`
+constexpr bool resourcePathMatches(const char *resourcePath, const char *path) {
+	while (*path == '/') ++path;
+	const char *p = path, *r = resourcePath;
+	while (*p && *p == *r) {
+		++p;
+		++r;
+	}
+	if (!*p && !*r) return true;
+	if (!*p && (p == path || p[-1] == '/')) {
+		const char *index = "index.html";
+		while (*index && *index == *r) {
+			++index;
+			++r;
+		}
+		return !*index && !*r;
+	}
+	return false;
+}
+
+template<size_t N>
+constexpr const EmbeddedResource * findResource(const EmbeddedResource (&table)[N], const char *path) {
+	for (auto &resource : table) {
+		if (resourcePathMatches(resource.path, path)) return &resource;
+	}
+	return nullptr;
+}
+
+}} // namespace
@@ -0,0 +1,363 @@
+#pragma once
+
+#include "clap/events.h"
+#include "clap/ext/state.h"
+#include "clap/plugin.h"
+#include "clap/process.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if !defined(__EMSCRIPTEN__) || defined(__EMSCRIPTEN_PTHREADS__)
+#	define SIGNALSMITH_CLAP_CAPTURE_THREAD 1
+#endif
+
+namespace signalsmith { namespace clap {
+
+/* Records each block's input events (plus the block size, steady time, and sample-rate from `activate()`) to a compact binary file, so a real session's event stream can be replayed exactly - see `clap-bench --replay`.
+
+Each plugin instance gets a stream (from a fixed pool, claimed on its first `activate()` and released by `.destroy()`) with its own lock-free byte ring.  On the audio thread, `.process()` copies the whole block's events into the ring (or drops the block if it's full), and a background thread writes them to a file.
+
+With `SIGNALSMITH_CLAP_CAPTURE` defined, `instrumentedPluginMethod()` calls `.activate()`/`.process()` for you, and `pluginDestroyMethod()` calls `.destroy()`.  It's off unless `.start()` is called:
+
+	// in clap_entry.init() - one file per plugin instance, in this directory
+	EventCapture::instance().startFromEnvironment("SIGNALSMITH_CLAP_CAPTURE");
+
+The file (native-endian) is a `FileHeader`, then records which each start with a `RecordHeader`:
+	tagActivate: `ActivateRecord`, then the plugin ID (`idBytes`, padded to 8 bytes), then the plugin's saved state (`stateBytes`) if it has `CLAP_EXT_STATE`
+	tagBlock: `BlockRecord`, then `eventCount` events, each copied verbatim and padded to 8 bytes
+An instance which is activated again just gets another `tagActivate` record (with the state at that point).
+*/
+struct EventCapture {
+	static constexpr size_t maxStreams = 64;
+	static constexpr size_t ringBytes = 1<<20; // per stream
+
+	struct FileHeader {
+		char magic[8] = {'S', 'S', 'C', 'L', 'A', 'P', 'E', 'V'};
+		uint32_t version = 2, reserved = 0;
+	};
+	enum Tag : uint32_t {tagActivate = 1, tagBlock = 2};
+	struct RecordHeader {
+		uint32_t tag, bytes; // `bytes` excludes this header
+	};
+	struct ActivateRecord {
+		double sampleRate;
+		uint32_t minFrames, maxFrames;
+		uint32_t idBytes, stateBytes;
+	};
+	struct BlockRecord {
+		int64_t steadyTime;
+		uint32_t frames, eventCount;
+		uint32_t droppedBefore; // blocks dropped (ring full) since the previous record
+		uint32_t reserved = 0;
+	};
+
+	static EventCapture & instance() {
+		static EventCapture capture;
+		return capture;
+	}
+
+	bool enabled() const {
+		return active.load(std::memory_order_relaxed);
+	}
+
+	// Main thread.  Starts capturing into the `directory` (if the environment variable is set and non-empty)
+	bool startFromEnvironment(const char *envVar) {
+		const char *dir = std::getenv(envVar);
+		if (!dir || !*dir) return false;
+		return start(dir);
+	}
+	bool start(const std::string &dir) {
+		std::lock_guard<std::mutex> guard{streamsMutex};
+		if (active.load()) return true;
+		directory = dir;
+		if (!directory.empty() && directory.back() != '/' && directory.back() != '\\') directory += '/';
+		active.store(true, std::memory_order_release);
+#ifdef SIGNALSMITH_CLAP_CAPTURE_THREAD
+		stopWriter.store(false);
+		writer = std::thread([this](){
+			while (!stopWriter.load(std::memory_order_acquire)) {
+				flush();
+				std::this_thread::sleep_for(std::chrono::milliseconds(20));
+			}
+		});
+#endif
+		return true;
+	}
+	// Main thread, once no plugins are processing.  Writes out everything and closes the files.
+	void stop() {
+		active.store(false, std::memory_order_release);
+#ifdef SIGNALSMITH_CLAP_CAPTURE_THREAD
+		stopWriter.store(true, std::memory_order_release);
+		if (writer.joinable()) writer.join();
+#endif
+		flush();
+		std::lock_guard<std::mutex> guard{streamsMutex};
+		for (auto &stream : streams) {
+			if (stream.file) std::fclose(stream.file);
+			stream.file = nullptr;
+			stream.plugin.store(nullptr, std::memory_order_release);
+		}
+	}
+
+	// Main thread (not real-time safe), before the plugin's `activate()`.  Also saves the plugin's state, so a replay starts from the same place.
+	void activate(const clap_plugin *plugin, double sampleRate, uint32_t minFrames, uint32_t maxFrames) {
+		if (!enabled()) return;
+		std::vector<unsigned char> state;
+		if (auto *stateExt = (const clap_plugin_state *)plugin->get_extension(plugin, CLAP_EXT_STATE)) {
+			const clap_ostream ostream{
+				.ctx=&state,
+				.write=[](const clap_ostream *ostream, const void *buffer, uint64_t size) -> int64_t {
+					auto &bytes = *(std::vector<unsigned char> *)ostream->ctx;
+					bytes.insert(bytes.end(), (const unsigned char *)buffer, (const unsigned char *)buffer + size);
+					return int64_t(size);
+				}
+			};
+			if (!stateExt->save(plugin, &ostream)) state.clear();
+		}
+
+		std::lock_guard<std::mutex> guard{streamsMutex};
+		Stream *stream = find(plugin);
+		if (!stream) stream = claim(plugin);
+		if (!stream) return;
+
+		// Written straight to the file (after anything still in the ring), since the state could be any size
+		flushStream(*stream);
+		const char *id = plugin->desc->id;
+		ActivateRecord record{sampleRate, minFrames, maxFrames, uint32_t(std::strlen(id)), uint32_t(state.size())};
+		RecordHeader header{tagActivate, uint32_t(sizeof(record) + padded(record.idBytes) + padded(record.stateBytes))};
+		static constexpr unsigned char zeros[8] = {};
+		std::fwrite(&header, sizeof(header), 1, stream->file);
+		std::fwrite(&record, sizeof(record), 1, stream->file);
+		std::fwrite(id, 1, record.idBytes, stream->file);
+		std::fwrite(zeros, 1, padded(record.idBytes) - record.idBytes, stream->file);
+		std::fwrite(state.data(), 1, state.size(), stream->file);
+		std::fwrite(zeros, 1, padded(state.size()) - state.size(), stream->file);
+		std::fflush(stream->file);
+	}
+
+	// Main thread, before the plugin's `destroy()`.  Finishes the instance's file, and frees its stream for another instance (which might reuse the same address).
+	void destroy(const clap_plugin *plugin) {
+		if (!enabled()) return; // `.stop()` has already closed everything
+		std::lock_guard<std::mutex> guard{streamsMutex};
+		Stream *stream = find(plugin);
+		if (!stream) return;
+		flushStream(*stream);
+		std::fclose(stream->file);
+		stream->file = nullptr;
+		stream->plugin.store(nullptr, std::memory_order_release);
+	}
+
+	// Audio thread (real-time safe), before the plugin's `process()`
+	void process(const clap_plugin *plugin, const clap_process *process) {
+		if (!enabled()) return;
+		Stream *stream = find(plugin);
+		if (!stream) return;
+
+		auto *events = process->in_events;
+		uint32_t eventCount = events->size(events);
+		size_t bytes = sizeof(BlockRecord);
+		for (uint32_t i = 0; i < eventCount; ++i) bytes += padded(events->get(events, i)->size);
+
+		size_t w = stream->writeIndex.load(std::memory_order_relaxed);
+		if (w + sizeof(RecordHeader) + bytes - stream->readIndex.load(std::memory_order_acquire) > ringBytes) {
+			++stream->droppedBlocks;
+			return;
+		}
+		RecordHeader header{tagBlock, uint32_t(bytes)};
+		BlockRecord record{process->steady_time, process->frames_count, eventCount, stream->droppedBlocks};
+		stream->droppedBlocks = 0;
+		w = stream->put(w, &header, sizeof(header));
+		w = stream->put(w, &record, sizeof(record));
+		for (uint32_t i = 0; i < eventCount; ++i) {
+			auto *event = events->get(events, i);
+			w = stream->put(w, event, event->size);
+			w = stream->pad(w);
+		}
+		stream->writeIndex.store(w, std::memory_order_release);
+	}
+
+	// Writes any pending records to the files.  Not real-time safe.
+	void flush() {
+		std::lock_guard<std::mutex> guard{streamsMutex};
+		for (auto &stream : streams) {
+			if (stream.file) flushStream(stream);
+		}
+	}
+
+	/* Reads a capture file back, one record at a time.
+
+		EventCapture::Reader reader{path};
+		while (reader.next()) {
+			if (reader.tag == EventCapture::tagBlock) ...
+		}
+	*/
+	struct Reader {
+		uint32_t tag = 0;
+		ActivateRecord activateRecord; // the latest one
+		std::string pluginId;
+		BlockRecord blockRecord;
+
+		std::vector<unsigned char> state; // empty if the plugin didn't have `CLAP_EXT_STATE`
+
+		Reader(const std::string &path) {
+			file = std::fopen(path.c_str(), "rb");
+			FileHeader expected, header;
+			if (file && (std::fread(&header, sizeof(header), 1, file) != 1 || std::memcmp(&header, &expected, sizeof(header)))) {
+				std::fclose(file);
+				file = nullptr;
+			}
+		}
+		~Reader() {
+			if (file) std::fclose(file);
+		}
+		Reader(const Reader &other) = delete;
+
+		explicit operator bool() const {
+			return file;
+		}
+
+		// Returns `false` at the end of the file (or a truncated record)
+		bool next() {
+			RecordHeader header;
+			if (!file || std::fread(&header, sizeof(header), 1, file) != 1) return false;
+			// Stored as `uint64_t`s, so the events are aligned
+			words.resize((header.bytes + 7)/8);
+			length = header.bytes;
+			if (length && std::fread(words.data(), 1, length, file) != length) return false;
+			auto *bytes = (const unsigned char *)words.data();
+			tag = header.tag;
+			offsets.clear();
+			if (tag == tagActivate && length >= sizeof(ActivateRecord)) {
+				std::memcpy(&activateRecord, bytes, sizeof(ActivateRecord));
+				size_t stateOffset = sizeof(ActivateRecord) + padded(activateRecord.idBytes);
+				if (stateOffset + activateRecord.stateBytes > length) return false;
+				pluginId.assign((const char *)bytes + sizeof(ActivateRecord), activateRecord.idBytes);
+				state.assign(bytes + stateOffset, bytes + stateOffset + activateRecord.stateBytes);
+			} else if (tag == tagBlock && length >= sizeof(BlockRecord)) {
+				std::memcpy(&blockRecord, bytes, sizeof(BlockRecord));
+				size_t offset = sizeof(BlockRecord);
+				for (uint32_t i = 0; i < blockRecord.eventCount; ++i) {
+					if (offset + sizeof(clap_event_header) > length) return false;
+					offsets.push_back(offset);
+					offset += padded(event(i)->size);
+				}
+			}
+			return true;
+		}
+
+		// Events from the current `tagBlock` record (8-byte aligned)
+		size_t eventCount() const {
+			return offsets.size();
+		}
+		const clap_event_header * event(size_t index) const {
+			return (const clap_event_header *)((const unsigned char *)words.data() + offsets[index]);
+		}
+
+	private:
+		std::FILE *file = nullptr;
+		std::vector<uint64_t> words;
+		size_t length = 0;
+		std::vector<size_t> offsets;
+	};
+
+private:
+	static size_t padded(size_t bytes) {
+		return (bytes + 7)&~size_t(7);
+	}
+
+	struct Stream {
+		std::atomic<const clap_plugin *> plugin{nullptr};
+		std::unique_ptr<unsigned char[]> ring; // allocated the first time it's claimed, and kept
+		std::FILE *file = nullptr;
+		uint32_t droppedBlocks = 0; // producer only
+		alignas(64) std::atomic<size_t> writeIndex{0};
+		alignas(64) std::atomic<size_t> readIndex{0};
+
+		// Producer only: copies into the ring at `w` (wrapping), returning the new write position
+		size_t put(size_t w, const void *data, size_t size) {
+			size_t offset = w%ringBytes;
+			size_t first = std::min(size, ringBytes - offset);
+			std::memcpy(ring.get() + offset, data, first);
+			std::memcpy(ring.get(), (const unsigned char *)data + first, size - first);
+			return w + size;
+		}
+		size_t pad(size_t w) {
+			static constexpr unsigned char zeros[8] = {};
+			return put(w, zeros, padded(w) - w);
+		}
+	};
+	std::array<Stream, maxStreams> streams;
+
+	std::atomic<bool> active{false};
+	std::mutex streamsMutex; // never touched by the audio thread
+	std::string directory;
+	size_t fileCounter = 0;
+#ifdef SIGNALSMITH_CLAP_CAPTURE_THREAD
+	std::atomic<bool> stopWriter{false};
+	std::thread writer;
+#endif
+
+	// With `streamsMutex` held
+	void flushStream(Stream &stream) {
+		size_t r = stream.readIndex.load(std::memory_order_relaxed);
+		size_t w = stream.writeIndex.load(std::memory_order_acquire);
+		while (r != w) {
+			size_t offset = r%ringBytes;
+			size_t chunk = std::min(w - r, ringBytes - offset);
+			std::fwrite(stream.ring.get() + offset, 1, chunk, stream.file);
+			r += chunk;
+		}
+		stream.readIndex.store(r, std::memory_order_release);
+		std::fflush(stream.file);
+	}
+
+	Stream * find(const clap_plugin *plugin) {
+		size_t start = (size_t(plugin)>>4)%maxStreams;
+		for (size_t i = 0; i < maxStreams; ++i) {
+			auto &stream = streams[(start + i)%maxStreams];
+			if (stream.plugin.load(std::memory_order_acquire) == plugin) return &stream;
+		}
+		return nullptr;
+	}
+	// Main thread, with `streamsMutex` held
+	Stream * claim(const clap_plugin *plugin) {
+		size_t start = (size_t(plugin)>>4)%maxStreams;
+		for (size_t i = 0; i < maxStreams; ++i) {
+			auto &stream = streams[(start + i)%maxStreams];
+			if (stream.plugin.load(std::memory_order_relaxed)) continue;
+
+			std::string name = plugin->desc->id;
+			for (auto &c : name) {
+				if (!std::isalnum((unsigned char)c) && c != '-' && c != '.') c = '_';
+			}
+			name = directory + name + "-" + std::to_string(++fileCounter) + ".clapevents";
+			stream.file = std::fopen(name.c_str(), "wb");
+			if (!stream.file) return nullptr;
+			FileHeader header;
+			std::fwrite(&header, sizeof(header), 1, stream.file);
+
+			if (!stream.ring) stream.ring.reset(new unsigned char[ringBytes]);
+			stream.readIndex.store(0);
+			stream.writeIndex.store(0);
+			stream.droppedBlocks = 0;
+			stream.plugin.store(plugin, std::memory_order_release);
+			return &stream;
+		}
+		return nullptr;
+	}
+};
+
+}} // namespace
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+
+namespace signalsmith { namespace clap {
+
+/* A histogram with logarithmic buckets (4 per octave), which any thread can add to without locking.
+
+Values from 2^-16 up to 2^48 are covered (anything outside that is clamped), so the same type works for nanoseconds, block sizes or ratios.  Each bucket is ~19% wide, which is the resolution of `.percentile()`.
+*/
+struct AtomicHistogram {
+	static constexpr int bucketsPerOctave = 4;
+	static constexpr int minOctave = -16, maxOctave = 48;
+	static constexpr int bucketCount = (maxOctave - minOctave)*bucketsPerOctave;
+
+	void add(double value) {
+		buckets[bucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+		total.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	uint64_t count() const {
+		return total.load(std::memory_order_relaxed);
+	}
+
+	// `p` from 0 to 1.  Returns 0 if it's empty.
+	double percentile(double p) const {
+		uint64_t n = count();
+		if (!n) return 0;
+		uint64_t target = uint64_t(std::ceil(p*n));
+		if (target < 1) target = 1;
+		uint64_t cumulative = 0;
+		for (int i = 0; i < bucketCount; ++i) {
+			cumulative += buckets[i].load(std::memory_order_relaxed);
+			if (cumulative >= target) return bucketValue(i);
+		}
+		return bucketValue(bucketCount - 1); // counts are still arriving from another thread
+	}
+
+	void reset() {
+		for (auto &b : buckets) b.store(0, std::memory_order_relaxed);
+		total.store(0, std::memory_order_relaxed);
+	}
+
+	static int bucketIndex(double value) {
+		if (!(value > 0)) return 0; // also NaN
+		int index = int(std::floor(std::log2(value)*bucketsPerOctave)) - minOctave*bucketsPerOctave;
+		return (index < 0) ? 0 : (index >= bucketCount) ? bucketCount - 1 : index;
+	}
+	// Geometric centre of the bucket
+	static double bucketValue(int index) {
+		return std::exp2((index + 0.5)/bucketsPerOctave + minOctave);
+	}
+
+private:
+	std::atomic<uint32_t> buckets[bucketCount] = {};
+	std::atomic<uint64_t> total{0};
+};
+
+}} // namespace
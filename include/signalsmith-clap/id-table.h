@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace signalsmith { namespace clap {
+
+constexpr uint32_t fnv1a(const char *str) {
+	uint32_t hash = 0x811C9DC5u;
+	while (*str) {
+		hash ^= (unsigned char)*str++;
+		hash *= 0x01000193u;
+	}
+	return hash;
+}
+
+template<class Value>
+struct IdEntry {
+	const char *id;
+	Value value;
+};
+
+/* A fixed hash table from string IDs (e.g. extension or plugin IDs) to values, for replacing `strcmp()` chains.
+
+The table is built in the constructor, which is `constexpr` - so a `static const` table with constant entries is filled out at compile-time.  A lookup hashes the query once, and only `strcmp()`s entries whose hash matches.
+
+	static const auto extensions = makeIdTable<const void *>({
+		{CLAP_EXT_STATE, &stateExt},
+		{CLAP_EXT_AUDIO_PORTS, &audioPortsExt}
+	});
+	return extensions.find(extId); // `nullptr` if not found
+*/
+template<class Value, size_t N>
+struct IdTable {
+	constexpr IdTable(const IdEntry<Value> (&entries)[N]) {
+		for (size_t i = 0; i < N; ++i) {
+			uint32_t hash = fnv1a(entries[i].id);
+			size_t slot = hash&(slotCount - 1);
+			while (slots[slot].id) slot = (slot + 1)&(slotCount - 1);
+			slots[slot] = {entries[i].id, entries[i].value, hash};
+		}
+	}
+
+	// Returns a default-constructed `Value` if not found
+	Value find(const char *id) const {
+		uint32_t hash = fnv1a(id);
+		for (size_t slot = hash&(slotCount - 1); slots[slot].id; slot = (slot + 1)&(slotCount - 1)) {
+			if (slots[slot].hash == hash && !std::strcmp(slots[slot].id, id)) return slots[slot].value;
+		}
+		return Value{};
+	}
+
+	static constexpr size_t size() {
+		return N;
+	}
+
+private:
+	// At least half empty, so probe sequences stay short
+	static constexpr size_t slotCountFor(size_t n) {
+		size_t count = 2;
+		while (count < n*2) count *= 2;
+		return count;
+	}
+	static constexpr size_t slotCount = slotCountFor(N);
+
+	struct Slot {
+		const char *id = nullptr;
+		Value value{};
+		uint32_t hash = 0;
+	};
+	Slot slots[slotCount] = {};
+};
+
+// Deduces the size from the list of entries
+template<class Value, size_t N>
+constexpr IdTable<Value, N> makeIdTable(const IdEntry<Value> (&entries)[N]) {
+	return IdTable<Value, N>(entries);
+}
+
+}} // namespace
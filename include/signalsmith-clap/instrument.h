@@ -0,0 +1,254 @@
+#pragma once
+
+#include "clap/plugin.h"
+#include "clap/process.h"
+
+#include "./cpp.h"
+#include "./histogram.h"
+#ifdef SIGNALSMITH_CLAP_RT_GUARD
+#	include "./perf-stats.h"
+#	include "./rt-guard.h"
+#endif
+#ifdef SIGNALSMITH_CLAP_CAPTURE
+#	include "./event-capture.h"
+#endif
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#	include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#	include <x86intrin.h>
+#endif
+
+#ifdef _MSC_VER
+#	define SIGNALSMITH_CLAP_FUNCTION_SIGNATURE __FUNCSIG__
+#else
+#	define SIGNALSMITH_CLAP_FUNCTION_SIGNATURE __PRETTY_FUNCTION__
+#endif
+
+namespace signalsmith { namespace clap {
+
+// CPU timestamp counter (on ARM, the virtual counter - which ticks at a fixed rate, not per cycle).  Returns 0 if we don't have one.
+inline uint64_t cycleCounter() {
+#if (defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))) || defined(__x86_64__) || defined(__i386__)
+	return __rdtsc();
+#elif defined(__aarch64__) && !defined(_MSC_VER)
+	uint64_t value;
+	asm volatile("mrs %0, cntvct_el0" : "=r"(value));
+	return value;
+#else
+	return 0;
+#endif
+}
+
+/* Per-instance timing for plugin callbacks, filled in by `instrumentedPluginMethod()` below.
+
+Give the plugin a member called `instrumentation`, and every callback made with `instrumentedPluginMethod()` records its wall-clock time and cycle count.  `process()` also records the block size, input event count, and deadline ratio (time spent / duration of the block).
+
+Everything is lock-free, and it never allocates, so it can stay enabled in production.  Any thread can read the stats at any time.
+*/
+struct Instrumentation {
+	static constexpr size_t maxCallbacks = 32;
+
+	struct CallStats {
+		// A string unique to each callback (the wrapper's function signature) - see `.name()`
+		std::atomic<const char *> signature{nullptr};
+		AtomicHistogram wallNs, cycles;
+
+		// Pulls out the method name (e.g. "ExampleSynth::pluginProcess") from the signature
+		std::string name() const {
+			const char *sig = signature.load(std::memory_order_acquire);
+			if (!sig) return "";
+			std::string str = sig;
+			// GCC/Clang: "... methodPtr ... = &Class::method;", MSVC: "callMethod<&Class::method>"
+			auto start = str.find("methodPtr");
+			start = (start == std::string::npos) ? str.find("<&") : str.find("= &", start);
+			if (start == std::string::npos) return str;
+			start = str.find('&', start) + 1;
+			auto end = str.find_first_of(";],>", start);
+			return str.substr(start, end - start);
+		}
+	};
+	std::array<CallStats, maxCallbacks> callbacks;
+
+	struct ProcessStats {
+		AtomicHistogram wallNs, blockSize, inputEvents, deadlineRatio;
+	};
+	ProcessStats process;
+
+	// Captured from `activate()`, for the deadline ratio
+	std::atomic<double> sampleRate{0};
+
+	// Finds (or claims) the slot for a callback - `nullptr` if they're all taken
+	CallStats * stats(const char *signature) {
+		size_t start = (size_t(signature)>>4)%maxCallbacks;
+		for (size_t i = 0; i < maxCallbacks; ++i) {
+			auto &slot = callbacks[(start + i)%maxCallbacks];
+			const char *existing = slot.signature.load(std::memory_order_acquire);
+			if (existing == signature) return &slot;
+			if (!existing) {
+				if (slot.signature.compare_exchange_strong(existing, signature, std::memory_order_acq_rel)) return &slot;
+				if (existing == signature) return &slot; // another thread claimed it for the same callback
+			}
+		}
+		return nullptr;
+	}
+	CallStats * find(const char *name) {
+		for (auto &slot : callbacks) {
+			if (slot.signature.load(std::memory_order_acquire) && slot.name() == name) return &slot;
+		}
+		return nullptr;
+	}
+
+	// One line per callback, for logging
+	std::string summary() const {
+		std::string result;
+		char line[256];
+		for (auto &slot : callbacks) {
+			if (!slot.wallNs.count()) continue;
+			std::snprintf(line, sizeof(line), "%s: %llu calls, median %.0fns, p99 %.0fns\n", slot.name().c_str(), (unsigned long long)slot.wallNs.count(), slot.wallNs.percentile(0.5), slot.wallNs.percentile(0.99));
+			result += line;
+		}
+		if (process.deadlineRatio.count()) {
+			std::snprintf(line, sizeof(line), "process deadline: median %.1f%%, p99 %.1f%%, max %.1f%%\n", process.deadlineRatio.percentile(0.5)*100, process.deadlineRatio.percentile(0.99)*100, process.deadlineRatio.percentile(1)*100);
+			result += line;
+		}
+		return result;
+	}
+};
+
+template <typename T>
+struct InstrumentedMethodHelper;
+
+/* Like `pluginMethod()`, but records into the object's `.instrumentation` member (if it has one).
+
+If `SIGNALSMITH_CLAP_RT_GUARD` is defined, `process()` also runs inside a `RtGuard::Scope`, counting any allocations into `.perfStats` (if the object has one).
+
+If `SIGNALSMITH_CLAP_CAPTURE` is defined, `activate()` and `process()` are passed to `EventCapture` (which does nothing unless it's been started).
+
+Don't use this for `destroy()`, since the timing is recorded after the method returns - use `pluginDestroyMethod()` instead.
+*/
+template<auto methodPtr>
+constexpr auto instrumentedPluginMethod() {
+	using C = InstrumentedMethodHelper<decltype(methodPtr)>;
+	return C::template callMethod<methodPtr>;
+}
+
+// For `clap_plugin.destroy()`: if `SIGNALSMITH_CLAP_CAPTURE` is defined, this lets `EventCapture` finish the instance's file first
+template<auto methodPtr>
+constexpr auto pluginDestroyMethod() {
+	using C = InstrumentedMethodHelper<decltype(methodPtr)>;
+	return C::template callDestroy<methodPtr>;
+}
+
+template <class Object, typename Return, typename... Args>
+struct InstrumentedMethodHelper<Return (Object::*)(Args...)> {
+	template<class O, class=void>
+	struct HasInstrumentation : std::false_type {};
+	template<class O>
+	struct HasInstrumentation<O, decltype((void)std::declval<O>().instrumentation)> : std::true_type {};
+
+	// Recognise the callbacks by their signatures
+	static constexpr bool isProcess = std::is_same<Return, clap_process_status>::value && std::is_same<std::tuple<Args...>, std::tuple<const clap_process *>>::value;
+	static constexpr bool isActivate = std::is_same<Return, bool>::value && std::is_same<std::tuple<Args...>, std::tuple<double, uint32_t, uint32_t>>::value;
+
+#ifdef SIGNALSMITH_CLAP_RT_GUARD
+	template<class O, class=void>
+	struct HasPerfStats : std::false_type {};
+	template<class O>
+	struct HasPerfStats<O, decltype((void)std::declval<O>().perfStats)> : std::true_type {};
+
+	struct NoGuard {};
+	static auto guardFor(Object *obj) {
+		if constexpr (!isProcess) {
+			return NoGuard{};
+		} else if constexpr (HasPerfStats<Object>::value) {
+			obj->perfStats.flags.fetch_or(CLAP_PERF_STATS_HAS_ALLOCATIONS, std::memory_order_relaxed);
+			return RtGuard::Scope{&obj->perfStats.audioThreadAllocations, &obj->perfStats.audioThreadLocks};
+		} else {
+			return RtGuard::Scope{};
+		}
+	}
+#endif
+
+	template<Return (Object::*methodPtr)(Args...)>
+	static Return callDestroy(const clap_plugin *plugin, Args... args) {
+#ifdef SIGNALSMITH_CLAP_CAPTURE
+		EventCapture::instance().destroy(plugin);
+#endif
+		return (((Object *)plugin->plugin_data)->*methodPtr)(args...);
+	}
+
+	template<Return (Object::*methodPtr)(Args...)>
+	static Return callMethod(const clap_plugin *plugin, Args... args) {
+		auto *obj = (Object *)plugin->plugin_data;
+#ifdef SIGNALSMITH_CLAP_CAPTURE
+		if constexpr (isActivate) {
+			std::tuple<Args...> argTuple{args...};
+			EventCapture::instance().activate(plugin, std::get<0>(argTuple), std::get<1>(argTuple), std::get<2>(argTuple));
+		} else if constexpr (isProcess) {
+			EventCapture::instance().process(plugin, std::get<0>(std::tuple<Args...>{args...}));
+		}
+#endif
+#ifdef SIGNALSMITH_CLAP_RT_GUARD
+		auto guard = guardFor(obj);
+#endif
+		if constexpr (!HasInstrumentation<Object>::value) {
+			return (obj->*methodPtr)(args...);
+		} else {
+			Instrumentation &instrumentation = obj->instrumentation;
+			if constexpr (isActivate) {
+				instrumentation.sampleRate.store(std::get<0>(std::tuple<Args...>{args...}), std::memory_order_relaxed);
+			}
+			uint32_t frames = 0, events = 0;
+			if constexpr (isProcess) {
+				const clap_process *process = std::get<0>(std::tuple<Args...>{args...});
+				frames = process->frames_count;
+				events = process->in_events->size(process->in_events);
+			}
+
+			const char *signature = SIGNALSMITH_CLAP_FUNCTION_SIGNATURE;
+			auto startTime = std::chrono::steady_clock::now();
+			uint64_t startCycles = cycleCounter();
+			auto record = [&](){
+				uint64_t cycles = cycleCounter() - startCycles;
+				double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - startTime).count();
+				if (auto *stats = instrumentation.stats(signature)) {
+					stats->wallNs.add(ns);
+					stats->cycles.add(double(cycles));
+				}
+				if constexpr (isProcess) {
+					auto &process = instrumentation.process;
+					process.wallNs.add(ns);
+					process.blockSize.add(frames);
+					process.inputEvents.add(events);
+					double sampleRate = instrumentation.sampleRate.load(std::memory_order_relaxed);
+					if (frames > 0 && sampleRate > 0) {
+						process.deadlineRatio.add(ns*sampleRate/(frames*1e9));
+					}
+				}
+			};
+
+			if constexpr (std::is_void<Return>::value) {
+				(obj->*methodPtr)(args...);
+				record();
+			} else {
+				Return result = (obj->*methodPtr)(args...);
+				record();
+				return result;
+			}
+		}
+	}
+};
+
+}} // namespace
@@ -0,0 +1,188 @@
+#pragma once
+
+#include "./thread-rings.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+
+#if !defined(__EMSCRIPTEN__) || defined(__EMSCRIPTEN_PTHREADS__)
+#	define SIGNALSMITH_CLAP_LOG_THREAD 1
+#endif
+
+namespace signalsmith { namespace clap {
+
+/* A logger which is safe to use from the audio thread.
+
+`.write()` just copies the format string pointer and the arguments into a fixed-size record, and pushes it into a per-thread wait-free queue.  The formatting and writing happens later, on a background thread (or whenever `.flush()` is called, if we don't have threads).
+
+The format uses `{}` for each argument:
+
+	Log::instance().write("unhandled note expression {} (value {})", expression, value);
+
+Arguments can be numbers, `bool`s or `const char *` - but strings are only stored as pointers, so they have to outlive the record (e.g. string literals).  Until `.start()` is called, nothing is recorded (and nothing is allocated), so it's started from an environment variable, the same way as `Trace`:
+
+	// in clap_entry.init() - e.g. `SIGNALSMITH_CLAP_LOG=stderr` or `SIGNALSMITH_CLAP_LOG=log.txt`
+	Log::instance().startFromEnvironment("SIGNALSMITH_CLAP_LOG");
+*/
+struct Log {
+	static constexpr size_t maxArgs = 4;
+	static constexpr size_t recordsPerThread = 1024;
+
+	struct Arg {
+		enum Type : uint8_t {none, signedInt, unsignedInt, real, boolean, string};
+		Type type = none;
+		union {
+			int64_t i;
+			uint64_t u;
+			double d;
+			const char *s;
+		};
+
+		Arg() : u(0) {}
+		template<class T, std::enable_if_t<std::is_integral<T>::value && std::is_signed<T>::value, int> = 0>
+		Arg(T v) : type(signedInt), i(v) {}
+		template<class T, std::enable_if_t<std::is_integral<T>::value && !std::is_signed<T>::value, int> = 0>
+		Arg(T v) : type(unsignedInt), u(v) {}
+		template<class T, std::enable_if_t<std::is_enum<T>::value, int> = 0>
+		Arg(T v) : Arg(std::underlying_type_t<T>(v)) {}
+		Arg(float v) : type(real), d(v) {}
+		Arg(double v) : type(real), d(v) {}
+		Arg(bool v) : type(boolean), u(v) {}
+		Arg(const char *v) : type(string), s(v) {}
+	};
+	struct Record {
+		const char *format;
+		Arg args[maxArgs];
+	};
+
+	static Log & instance() {
+		static Log log;
+		return log;
+	}
+
+	// Main thread.  Starts logging to `stdout`/`stderr` or a file (if the environment variable is set and non-empty)
+	bool startFromEnvironment(const char *envVar) {
+		const char *value = std::getenv(envVar);
+		if (!value || !*value) return false;
+		if (active.load()) return true;
+		if (!std::strcmp(value, "stdout") || !std::strcmp(value, "1")) {
+			start(stdout);
+		} else if (!std::strcmp(value, "stderr")) {
+			start(stderr);
+		} else {
+			std::FILE *file = std::fopen(value, "w");
+			if (!file) return false;
+			start(file);
+			ownsOutput = true;
+		}
+		return true;
+	}
+	// Main thread.  Starts recording, and the background writer (if we have threads)
+	void start(std::FILE *output=stdout) {
+		std::lock_guard<std::mutex> guard{writeMutex};
+		if (active.load()) return;
+		out = output;
+		ownsOutput = false;
+		rings.allocate();
+		active.store(true, std::memory_order_release);
+#ifdef SIGNALSMITH_CLAP_LOG_THREAD
+		stopWriter.store(false);
+		writer = std::thread([this](){
+			while (!stopWriter.load(std::memory_order_acquire)) {
+				flush();
+				std::this_thread::sleep_for(std::chrono::milliseconds(20));
+			}
+		});
+#endif
+	}
+	// Main thread.  Stops the writer, and writes out anything left
+	void stop() {
+		active.store(false, std::memory_order_release);
+#ifdef SIGNALSMITH_CLAP_LOG_THREAD
+		stopWriter.store(true, std::memory_order_release);
+		if (writer.joinable()) writer.join();
+#endif
+		flush();
+		std::lock_guard<std::mutex> guard{writeMutex};
+		if (out && ownsOutput) std::fclose(out);
+		out = nullptr;
+		ownsOutput = false;
+	}
+
+	// Any thread (real-time safe).  Returns `false` if it wasn't recorded.
+	template<class ...Args>
+	bool write(const char *format, Args ...args) {
+		static_assert(sizeof...(Args) <= maxArgs, "too many log arguments");
+		if (!active.load(std::memory_order_relaxed)) return false;
+		return rings.push(Record{format, {Arg(args)...}});
+	}
+
+	// Formats and writes any pending records.  Not real-time safe.
+	void flush() {
+		std::lock_guard<std::mutex> guard{writeMutex};
+		if (!out) return;
+		Record record;
+		std::string line;
+		rings.forEachRing([&](auto &ring){
+			if (uint64_t dropped = ring.takeDropped()) {
+				std::fprintf(out, "(dropped %llu log messages)\n", (unsigned long long)dropped);
+			}
+			while (ring.items.pop(record)) {
+				format(record, line);
+				std::fwrite(line.data(), 1, line.size(), out);
+			}
+		});
+		if (uint64_t dropped = rings.takeUnclaimedDropped()) {
+			std::fprintf(out, "(dropped %llu log messages from threads without a ring)\n", (unsigned long long)dropped);
+		}
+		std::fflush(out);
+	}
+
+	static void format(const Record &record, std::string &line) {
+		line.clear();
+		size_t argIndex = 0;
+		char number[32];
+		for (const char *c = record.format; *c; ++c) {
+			if (c[0] != '{' || c[1] != '}' || argIndex >= maxArgs) {
+				line += *c;
+				continue;
+			}
+			++c;
+			auto &arg = record.args[argIndex++];
+			switch (arg.type) {
+				case Arg::none: line += "{}"; break;
+				case Arg::signedInt: std::snprintf(number, sizeof(number), "%lld", (long long)arg.i); line += number; break;
+				case Arg::unsignedInt: std::snprintf(number, sizeof(number), "%llu", (unsigned long long)arg.u); line += number; break;
+				case Arg::real: std::snprintf(number, sizeof(number), "%g", arg.d); line += number; break;
+				case Arg::boolean: line += (arg.u ? "true" : "false"); break;
+				case Arg::string: line += (arg.s ? arg.s : "(null)"); break;
+			}
+		}
+		line += '\n';
+	}
+
+private:
+	std::atomic<bool> active{false};
+	ThreadRings<Record, recordsPerThread> rings;
+
+	std::mutex writeMutex; // only contended between `.flush()` callers, never the audio thread
+	std::FILE *out = nullptr;
+	bool ownsOutput = false;
+#ifdef SIGNALSMITH_CLAP_LOG_THREAD
+	std::atomic<bool> stopWriter{false};
+	std::thread writer;
+#endif
+};
+
+}} // namespace
+
+// Logs an expression and its value (without blocking), e.g. `SIGNALSMITH_CLAP_LOG_EXPR(note.key)`
+#define SIGNALSMITH_CLAP_LOG_EXPR(expr) signalsmith::clap::Log::instance().write(#expr " = {}", (expr))
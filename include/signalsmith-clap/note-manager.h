@@ -21,6 +21,13 @@ struct NoteManager {
 	// 2 for default MIDI, 48 for most MPE
 	double pitchWheelRange = 2;
 	struct NoteMod;
+
+	// Running totals (never reset), e.g. for performance stats
+	struct Counters {
+		uint64_t stolen = 0;
+		uint64_t zeroLengthKills = 0; // stolen with no time to fade out
+	};
+	Counters counters;
 	
 	struct Note {
 		// Note info
@@ -190,6 +197,8 @@ struct NoteManager {
 			auto &killNote = notes[killIndex];
 			killNote.state = stateKill;
 			killNote.processTo = newNote.processFrom;
+			++counters.stolen;
+			if (killNote.processTo <= killNote.processFrom) ++counters.zeroLengthKills;
 			// Push this task even if it's zero length
 			tasks.push_back(killNote);
 			stop(killNote, eventsOut);
@@ -0,0 +1,108 @@
+#pragma once
+
+#include "./cpp.h"
+#include "./params.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace signalsmith { namespace clap {
+
+/* A versioned binary state format for a `ParamRegistry`:
+
+	header: magic, format version, header size, layout version, parameter count
+	parameter IDs: `uint32_t` for each parameter
+	values: `double` for each parameter, contiguous
+
+The "layout version" belongs to the plugin, and should change whenever parameters are added/removed/reordered.  If it (and the ID table) matches, the values are read as one block and assigned by index.  Otherwise, they're matched up by parameter ID.
+
+Everything is in native (little-endian) byte order - a mismatched magic number is treated as "not this format".
+
+The format version is only bumped for incompatible changes.  Compatible additions go on the end of the header (increasing `headerBytes`), and older readers skip them.
+*/
+struct ParamStateHeader {
+	static constexpr uint32_t magicNumber = 0x53505353; // "SSPS"
+	static constexpr uint16_t currentFormat = 1;
+
+	uint32_t magic = magicNumber;
+	uint16_t formatVersion = currentFormat;
+	uint16_t headerBytes = sizeof(ParamStateHeader);
+	uint32_t layoutVersion = 0;
+	uint32_t paramCount = 0;
+};
+
+enum class ParamStateResult {
+	loaded, // same layout, loaded directly
+	migrated, // different layout, matched by parameter ID
+	otherFormat, // not this format - the bytes are returned so you can try something else
+	error
+};
+
+inline bool saveParamState(const ParamRegistry &params, uint32_t layoutVersion, const clap_ostream *ostream) {
+	ParamStateHeader header;
+	header.layoutVersion = layoutVersion;
+	header.paramCount = uint32_t(params.size());
+
+	StreamWriter<> writer{ostream};
+	writer.write(&header, sizeof(header));
+	writer.write(params.paramIds().data(), params.size()*sizeof(clap_id));
+	for (auto *param : params) {
+		double value = param->value;
+		writer.write(&value, sizeof(double));
+	}
+	return writer.flush();
+}
+
+// If it's not this format, any bytes (including the ones already read) are put in `otherBytes`
+template<class Container>
+ParamStateResult loadParamState(ParamRegistry &params, uint32_t layoutVersion, const clap_istream *istream, Container &otherBytes) {
+	using Result = ParamStateResult;
+	StreamReader<> reader{istream};
+
+	ParamStateHeader header;
+	size_t headerRead = reader.read(&header, sizeof(header));
+	if (headerRead < sizeof(header) || header.magic != ParamStateHeader::magicNumber) {
+		auto *headerBytes = (const unsigned char *)&header;
+		otherBytes.assign(headerBytes, headerBytes + headerRead);
+		return reader.readRest(otherBytes) ? Result::otherFormat : Result::error;
+	}
+	if (header.formatVersion > ParamStateHeader::currentFormat) return Result::error; // incompatible, from the future
+	if (header.headerBytes < sizeof(header)) return Result::error;
+	// Skip any header fields we don't know about (compatible additions, with the same format version)
+	for (size_t i = sizeof(header); i < header.headerBytes; ++i) {
+		unsigned char ignored;
+		if (!reader.readByte(ignored)) return Result::error;
+	}
+	// Sanity-check before we allocate anything
+	constexpr uint32_t maxParams = 0x10000;
+	if (header.paramCount > maxParams) return Result::error;
+
+	std::vector<clap_id> ids(header.paramCount);
+	std::vector<double> values(header.paramCount);
+	size_t idBytes = ids.size()*sizeof(clap_id), valueBytes = values.size()*sizeof(double);
+	if (reader.read(ids.data(), idBytes) != idBytes) return Result::error;
+	if (reader.read(values.data(), valueBytes) != valueBytes) return Result::error;
+
+	auto setValue = [](Param &param, double value){
+		if (!(value >= param.info.min_value)) value = param.info.min_value; // also catches NaN
+		if (value > param.info.max_value) value = param.info.max_value;
+		param.value = value;
+		param.sentUiState.clear();
+	};
+
+	if (header.layoutVersion == layoutVersion && ids == params.paramIds()) {
+		for (size_t i = 0; i < values.size(); ++i) {
+			setValue(*params[i], values[i]);
+		}
+		return Result::loaded;
+	}
+
+	// Anything the saved state doesn't mention (e.g. parameters added since) goes back to its default
+	params.resetToDefaults();
+	for (size_t i = 0; i < ids.size(); ++i) {
+		if (auto *param = params.find(ids[i])) setValue(*param, values[i]);
+	}
+	return Result::migrated;
+}
+
+}} // namespace
@@ -3,31 +3,40 @@
 #include "clap/events.h"
 #include "clap/ext/params.h"
 
+#include "./cpp.h"
+#include "./spsc-queue.h"
+
+#include <algorithm>
 #include <atomic>
+#include <cstring>
+#include <cstdio>
+#include <cstdlib>
 #include <functional>
+#include <initializer_list>
+#include <string>
+#include <vector>
 
 namespace signalsmith { namespace clap {
 
 /* A parameter object which can send gesture/value events back to the host when needed.
 
+The value is atomic, so it can be read from any thread without tearing.  It should only be *changed* by the thread currently handling events (the audio thread, `params.flush()` when inactive, or state-loading).
+
+User interactions from the UI go into a lock-free queue by calling `.uiGestureStart()`, `.uiValue()` and `.uiGestureEnd()`.  These are applied (and sent to the host) in order, by `.sendEvents()`.
+
 It can also track whether its value has been sent to the UI or not, but doesn't specify how that should be done.
 */
 struct Param {
-	double value = 0;
+	std::atomic<double> value;
 	clap_param_info info;
 	const char *formatString = "%.2f";
 	std::function<std::string(double)> formatFn;
 	const char *key; // useful when debugging, or when an integer key is awkward
-	
-	// User interactions which we need to send as events to the host
-	std::atomic_flag sentValue = ATOMIC_FLAG_INIT;
-	std::atomic_flag sentGestureStart = ATOMIC_FLAG_INIT;
-	std::atomic_flag sentGestureEnd = ATOMIC_FLAG_INIT;
 
 	// Value change which we might need to send to the UI
 	std::atomic_flag sentUiState = ATOMIC_FLAG_INIT;
 
-	Param(const char *key, const char *name, clap_id paramId, double min, double initial, double max) : key(key), value(initial) {
+	Param(const char *key, const char *name, clap_id paramId, double min, double initial, double max) : value(initial), key(key) {
 		info = {
 			.id=paramId,
 			.flags=CLAP_PARAM_IS_AUTOMATABLE,
@@ -39,10 +48,6 @@ struct Param {
 			.default_value=initial
 		};
 		std::strncpy(info.name, name, CLAP_NAME_SIZE);
-		
-		sentValue.test_and_set();
-		sentGestureStart.test_and_set();
-		sentGestureEnd.test_and_set();
 	}
 	
 	void setValueFromEvent(const clap_event_param_value &paramEvent) {
@@ -50,53 +55,244 @@ struct Param {
 		sentUiState.clear();
 	}
 
+	// UI thread only
+	void uiGestureStart() {
+		// If the previous gesture's end hasn't been sent yet, just continue that gesture
+		if (pending.fetch_and(~pendingEnd, std::memory_order_acq_rel)&pendingEnd) return;
+		uiPush({CLAP_EVENT_PARAM_GESTURE_BEGIN, 0}, pendingBegin);
+	}
+	void uiValue(double v) {
+		if (pending.load(std::memory_order_acquire) || !uiEvents.push({CLAP_EVENT_PARAM_VALUE, v})) {
+			overflowValue.store(v, std::memory_order_relaxed);
+			pending.fetch_or(pendingValue, std::memory_order_release);
+		}
+	}
+	void uiGestureEnd() {
+		uiPush({CLAP_EVENT_PARAM_GESTURE_END, 0}, pendingEnd);
+	}
+
+	// Audio thread (or `params.flush()`) only
 	void sendEvents(const clap_output_events *outEvents) {
-		if (!sentGestureStart.test_and_set()) {
-			clap_event_param_gesture event{
-				.header={
-					.size=sizeof(clap_event_param_gesture),
-					.time=0,
-					.space_id=CLAP_CORE_EVENT_SPACE_ID,
-					.type=CLAP_EVENT_PARAM_GESTURE_BEGIN,
-					.flags=CLAP_EVENT_IS_LIVE
-				},
-				.param_id=info.id
-			};
-			outEvents->try_push(outEvents, &event.header);
+		UiEvent uiEvent;
+		while (uiEvents.pop(uiEvent)) {
+			if (uiEvent.type == CLAP_EVENT_PARAM_VALUE) {
+				sendValue(uiEvent.value, outEvents);
+			} else {
+				sendGesture(uiEvent.type, outEvents);
+			}
 		}
-		if (!sentValue.test_and_set()) {
-			clap_event_param_value event{
-				.header={
-					.size=sizeof(clap_event_param_value),
-					.time=0,
-					.space_id=CLAP_CORE_EVENT_SPACE_ID,
-					.type=CLAP_EVENT_PARAM_VALUE,
-					.flags=CLAP_EVENT_IS_LIVE
-				},
-				.param_id=info.id,
-				.cookie=this,
-				.note_id=-1,
-				.port_index=-1,
-				.channel=-1,
-				.key=-1,
-				.value=value
-			};
-			outEvents->try_push(outEvents, &event.header);
+		// Anything which didn't fit in the queue, collapsed down to (begin, latest value, end)
+		uint32_t overflow = pending.exchange(0, std::memory_order_acq_rel);
+		if (overflow&pendingBegin) sendGesture(CLAP_EVENT_PARAM_GESTURE_BEGIN, outEvents);
+		if (overflow&pendingValue) sendValue(overflowValue.load(std::memory_order_relaxed), outEvents);
+		if (overflow&pendingEnd) sendGesture(CLAP_EVENT_PARAM_GESTURE_END, outEvents);
+	}
+
+private:
+	struct UiEvent {
+		uint16_t type;
+		double value;
+	};
+	SpscQueue<UiEvent, 64> uiEvents;
+
+	/* If the queue fills up, we switch to a fallback: the latest value, and flags for whether there's a gesture begin/end.  Once this is in use, everything goes through it (so nothing overtakes it in the queue) until the audio thread has sent it.
+
+	This loses intermediate values, but the host still ends up on the latest value, with every gesture closed. */
+	static constexpr uint32_t pendingBegin = 1, pendingValue = 2, pendingEnd = 4;
+	std::atomic<uint32_t> pending{0};
+	std::atomic<double> overflowValue{0};
+
+	void uiPush(UiEvent event, uint32_t pendingFlag) {
+		if (pending.load(std::memory_order_acquire) || !uiEvents.push(event)) {
+			pending.fetch_or(pendingFlag, std::memory_order_release);
 		}
-		if (!sentGestureEnd.test_and_set()) {
-			clap_event_param_gesture event{
-				.header={
-					.size=sizeof(clap_event_param_gesture),
-					.time=0,
-					.space_id=CLAP_CORE_EVENT_SPACE_ID,
-					.type=CLAP_EVENT_PARAM_GESTURE_END,
-					.flags=CLAP_EVENT_IS_LIVE
-				},
-				.param_id=info.id
-			};
-			outEvents->try_push(outEvents, &event.header);
+	}
+
+	void sendGesture(uint16_t type, const clap_output_events *outEvents) {
+		clap_event_param_gesture event{
+			.header={
+				.size=sizeof(clap_event_param_gesture),
+				.time=0,
+				.space_id=CLAP_CORE_EVENT_SPACE_ID,
+				.type=type,
+				.flags=CLAP_EVENT_IS_LIVE
+			},
+			.param_id=info.id
+		};
+		outEvents->try_push(outEvents, &event.header);
+	}
+	void sendValue(double v, const clap_output_events *outEvents) {
+		value = v;
+		clap_event_param_value event{
+			.header={
+				.size=sizeof(clap_event_param_value),
+				.time=0,
+				.space_id=CLAP_CORE_EVENT_SPACE_ID,
+				.type=CLAP_EVENT_PARAM_VALUE,
+				.flags=CLAP_EVENT_IS_LIVE
+			},
+			.param_id=info.id,
+			.cookie=this,
+			.note_id=-1,
+			.port_index=-1,
+			.channel=-1,
+			.key=-1,
+			.value=v
+		};
+		outEvents->try_push(outEvents, &event.header);
+	}
+};
+
+/* A fixed list of parameters, with constant-time lookup by ID (using a small hash-table built in the constructor).
+
+It can fill out the `clap_plugin_params` extension for you - except `.flush()`, since that depends on how the plugin handles events.
+*/
+struct ParamRegistry {
+	ParamRegistry(std::initializer_list<Param *> list) : params(list) {
+		ids.reserve(params.size());
+		for (auto *param : params) ids.push_back(param->info.id);
+
+		// At least half empty, so probe sequences stay short
+		size_t slotCount = 2;
+		slotShift = 31;
+		while (slotCount < params.size()*2) {
+			slotCount *= 2;
+			--slotShift;
 		}
+		slots.assign(slotCount, 0);
+		slotMask = uint32_t(slotCount - 1);
+		for (size_t i = 0; i < params.size(); ++i) {
+			uint32_t slot = hashId(ids[i]);
+			while (slots[slot]) slot = (slot + 1)&slotMask;
+			slots[slot] = uint32_t(i + 1);
+		}
+	}
+	
+	size_t size() const {
+		return params.size();
 	}
+	Param * operator[](size_t index) const {
+		return params[index];
+	}
+	auto begin() const {
+		return params.begin();
+	}
+	auto end() const {
+		return params.end();
+	}
+	// All the IDs in order, as a contiguous list
+	const std::vector<clap_id> & paramIds() const {
+		return ids;
+	}
+
+	// e.g. before loading a state which might not include every parameter
+	void resetToDefaults() {
+		for (auto *param : params) {
+			param->value = param->info.default_value;
+			param->sentUiState.clear();
+		}
+	}
+
+	Param * find(clap_id paramId) const {
+		uint32_t slot = hashId(paramId);
+		while (uint32_t index = slots[slot]) {
+			if (ids[index - 1] == paramId) return params[index - 1];
+			slot = (slot + 1)&slotMask;
+		}
+		return nullptr;
+	}
+	Param * find(const clap_event_param_value &event) const {
+		// If provided, the cookie is the parameter
+		if (event.cookie) return (Param *)event.cookie;
+		return find(event.param_id);
+	}
+	
+	// ---- `clap_plugin_params` methods ----
+
+	uint32_t count() const {
+		return uint32_t(params.size());
+	}
+	bool getInfo(uint32_t index, clap_param_info *info) const {
+		if (index >= params.size()) return false;
+		*info = params[index]->info;
+		return true;
+	}
+	bool getValue(clap_id paramId, double *value) const {
+		auto *param = find(paramId);
+		if (!param) return false;
+		*value = param->value;
+		return true;
+	}
+	bool valueToText(clap_id paramId, double value, char *text, uint32_t textCapacity) const {
+		auto *param = find(paramId);
+		if (!param) return false;
+		if (param->formatFn) {
+			auto str = param->formatFn(value);
+			std::strncpy(text, str.c_str(), textCapacity);
+		} else {
+			std::snprintf(text, textCapacity, param->formatString, value);
+		}
+		return true;
+	}
+	bool textToValue(clap_id paramId, const char *text, double *value) const {
+		auto *param = find(paramId);
+		if (!param) return false;
+		char *numberEnd;
+		double v = std::strtod(text, &numberEnd);
+		if (numberEnd == text) return false;
+		*value = std::max(param->info.min_value, std::min(param->info.max_value, v));
+		return true;
+	}
+	
+	// Makes the extension, where `registryPtr` is a member of the plugin (`&Plugin::params`)
+	template<auto registryPtr, auto flushMethodPtr>
+	static constexpr const clap_plugin_params * extension() {
+		return &extensionStruct<registryPtr, flushMethodPtr>;
+	}
+
+private:
+	std::vector<Param *> params;
+	std::vector<clap_id> ids;
+	std::vector<uint32_t> slots; // index + 1, or 0 for empty
+	uint32_t slotMask, slotShift;
+
+	// Fibonacci hashing, using the top bits
+	uint32_t hashId(clap_id paramId) const {
+		return uint32_t(paramId*0x9E3779B1u) >> slotShift;
+	}
+
+	template<class MemberPtr>
+	struct MemberOf;
+	template<class Object, class Member>
+	struct MemberOf<Member Object::*> {
+		using Class = Object;
+	};
+
+	template<auto registryPtr>
+	static const ParamRegistry & of(const clap_plugin *plugin) {
+		using Plugin = typename MemberOf<decltype(registryPtr)>::Class;
+		return ((const Plugin *)plugin->plugin_data)->*registryPtr;
+	}
+
+	template<auto registryPtr, auto flushMethodPtr>
+	static constexpr clap_plugin_params extensionStruct{
+		.count=[](const clap_plugin *plugin) -> uint32_t {
+			return of<registryPtr>(plugin).count();
+		},
+		.get_info=[](const clap_plugin *plugin, uint32_t index, clap_param_info *info) -> bool {
+			return of<registryPtr>(plugin).getInfo(index, info);
+		},
+		.get_value=[](const clap_plugin *plugin, clap_id paramId, double *value) -> bool {
+			return of<registryPtr>(plugin).getValue(paramId, value);
+		},
+		.value_to_text=[](const clap_plugin *plugin, clap_id paramId, double value, char *text, uint32_t textCapacity) -> bool {
+			return of<registryPtr>(plugin).valueToText(paramId, value, text, textCapacity);
+		},
+		.text_to_value=[](const clap_plugin *plugin, clap_id paramId, const char *text, double *value) -> bool {
+			return of<registryPtr>(plugin).textToValue(paramId, text, value);
+		},
+		.flush=pluginMethod<flushMethodPtr>()
+	};
 };
 
 }} // namespace
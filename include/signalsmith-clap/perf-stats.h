@@ -0,0 +1,147 @@
+#pragma once
+
+#include "clap/events.h"
+#include "clap/plugin.h"
+
+#include "./histogram.h"
+
+#include <atomic>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+namespace signalsmith { namespace clap {
+
+// ---- Vendor extension, for hosts/tools to query how a plugin is performing ----
+
+static constexpr const char CLAP_EXT_PERF_STATS[] = "uk.co.signalsmith-audio.perf-stats/2";
+
+enum {
+	CLAP_PERF_STATS_HAS_VOICES = 1 << 0, // `active_voices`/`voices_stolen`/`zero_length_kills` are meaningful
+	CLAP_PERF_STATS_HAS_TIMING = 1 << 1, // process timing/deadline percentiles are filled out
+	CLAP_PERF_STATS_HAS_ALLOCATIONS = 1 << 2, // audio-thread allocations and mutex locks are being counted
+};
+
+typedef struct clap_perf_stats {
+	uint32_t flags; // CLAP_PERF_STATS_HAS_*
+
+	uint32_t active_voices;
+	uint64_t voices_stolen;
+	uint64_t zero_length_kills; // stolen voices which got no samples to fade out
+	uint64_t dropped_events; // `try_push()` failures
+
+	uint64_t process_calls;
+	double process_ns_p50, process_ns_p90, process_ns_p99, process_ns_max;
+	// Time spent in `process()`, divided by the block's duration
+	double deadline_p50, deadline_p99, deadline_max;
+
+	uint64_t audio_thread_allocations;
+	uint64_t audio_thread_locks;
+} clap_perf_stats_t;
+
+typedef struct clap_plugin_perf_stats {
+	// [thread-safe] - values are running totals since the plugin was created
+	bool (*get)(const clap_plugin *plugin, clap_perf_stats_t *stats);
+} clap_plugin_perf_stats_t;
+
+/* Wraps a `clap_output_events`, counting any events the host refuses.
+
+	CountingOutputEvents eventsOut{process->out_events, perfStats.droppedEvents};
+	noteManager.processEvent(event, &eventsOut);
+*/
+struct CountingOutputEvents : public clap_output_events {
+	CountingOutputEvents(const clap_output_events *inner, std::atomic<uint64_t> &dropped) : clap_output_events{this, tryPush}, inner(inner), dropped(dropped) {}
+	CountingOutputEvents(const CountingOutputEvents &other) = delete; // `.ctx` points to this
+
+private:
+	const clap_output_events *inner;
+	std::atomic<uint64_t> &dropped;
+
+	static bool tryPush(const clap_output_events *list, const clap_event_header *event) {
+		auto &self = *(const CountingOutputEvents *)list->ctx;
+		if (self.inner->try_push(self.inner, event)) return true;
+		self.dropped.fetch_add(1, std::memory_order_relaxed);
+		return false;
+	}
+};
+
+/* Lock-free counters behind the `perf-stats` extension.
+
+The audio thread updates these (cheap relaxed atomics), and any thread can read them.  Process timing comes from the plugin's `instrumentation` member (see `instrument.h`) if it has one.
+*/
+struct PerfStats {
+	std::atomic<uint32_t> activeVoices{0};
+	std::atomic<uint64_t> voicesStolen{0}, zeroLengthKills{0};
+	std::atomic<uint64_t> droppedEvents{0};
+	std::atomic<uint64_t> audioThreadAllocations{0}, audioThreadLocks{0}; // counted by `RtGuard` (see `rt-guard.h`), in debug builds
+	std::atomic<uint32_t> flags{0};
+
+	// Call at the end of each block, if you're using a `NoteManager`
+	template<class NoteManager>
+	void updateVoices(const NoteManager &noteManager) {
+		activeVoices.store(uint32_t(noteManager.activeNotes().size()), std::memory_order_relaxed);
+		voicesStolen.store(noteManager.counters.stolen, std::memory_order_relaxed);
+		zeroLengthKills.store(noteManager.counters.zeroLengthKills, std::memory_order_relaxed);
+		flags.fetch_or(CLAP_PERF_STATS_HAS_VOICES, std::memory_order_relaxed);
+	}
+
+	void get(clap_perf_stats_t &stats) const {
+		stats = {};
+		stats.flags = flags.load(std::memory_order_relaxed);
+		stats.active_voices = activeVoices.load(std::memory_order_relaxed);
+		stats.voices_stolen = voicesStolen.load(std::memory_order_relaxed);
+		stats.zero_length_kills = zeroLengthKills.load(std::memory_order_relaxed);
+		stats.dropped_events = droppedEvents.load(std::memory_order_relaxed);
+		stats.audio_thread_allocations = audioThreadAllocations.load(std::memory_order_relaxed);
+		stats.audio_thread_locks = audioThreadLocks.load(std::memory_order_relaxed);
+	}
+	template<class Instrumentation>
+	static void getTiming(const Instrumentation &instrumentation, clap_perf_stats_t &stats) {
+		auto &wallNs = instrumentation.process.wallNs;
+		if (!wallNs.count()) return;
+		stats.flags |= CLAP_PERF_STATS_HAS_TIMING;
+		stats.process_calls = wallNs.count();
+		stats.process_ns_p50 = wallNs.percentile(0.5);
+		stats.process_ns_p90 = wallNs.percentile(0.9);
+		stats.process_ns_p99 = wallNs.percentile(0.99);
+		stats.process_ns_max = wallNs.percentile(1);
+		auto &deadline = instrumentation.process.deadlineRatio;
+		stats.deadline_p50 = deadline.percentile(0.5);
+		stats.deadline_p99 = deadline.percentile(0.99);
+		stats.deadline_max = deadline.percentile(1);
+	}
+
+	// Makes the extension, where `statsPtr` is a member of the plugin (`&Plugin::perfStats`)
+	template<auto statsPtr>
+	static constexpr const clap_plugin_perf_stats * extension() {
+		return &extensionStruct<statsPtr>;
+	}
+
+private:
+	template<class MemberPtr>
+	struct MemberOf;
+	template<class Object, class Member>
+	struct MemberOf<Member Object::*> {
+		using Class = Object;
+	};
+
+	template<class O, class=void>
+	struct HasInstrumentation : std::false_type {};
+	template<class O>
+	struct HasInstrumentation<O, decltype((void)std::declval<O>().instrumentation)> : std::true_type {};
+
+	template<auto statsPtr>
+	static constexpr clap_plugin_perf_stats extensionStruct{
+		.get=[](const clap_plugin *plugin, clap_perf_stats_t *stats) -> bool {
+			using Plugin = typename MemberOf<decltype(statsPtr)>::Class;
+			auto *obj = (Plugin *)plugin->plugin_data;
+			(obj->*statsPtr).get(*stats);
+			if constexpr (HasInstrumentation<Plugin>::value) {
+				getTiming(obj->instrumentation, *stats);
+			}
+			return true;
+		}
+	};
+};
+
+}} // namespace
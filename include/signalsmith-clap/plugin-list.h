@@ -0,0 +1,49 @@
+#pragma once
+
+#include "clap/factory/plugin-factory.h"
+
+#include "./id-table.h"
+
+namespace signalsmith { namespace clap {
+
+/* Makes a `clap_plugin_factory` from a list of plugin classes.
+
+Each class needs:
+	static const clap_plugin_descriptor * getPluginDescriptor();
+	static const clap_plugin * create(const clap_host *host);
+*/
+template<class... Plugins>
+struct PluginList {
+	static constexpr uint32_t count = sizeof...(Plugins);
+
+	static const clap_plugin_descriptor * descriptor(uint32_t index) {
+		static const clap_plugin_descriptor * descriptors[] = {Plugins::getPluginDescriptor()...};
+		return (index < count) ? descriptors[index] : nullptr;
+	}
+
+	static const clap_plugin * create(const clap_host *host, const char *pluginId) {
+		using CreateFn = const clap_plugin * (*)(const clap_host *);
+		static const auto creators = makeIdTable<CreateFn>({
+			{Plugins::getPluginDescriptor()->id, &Plugins::create}...
+		});
+		CreateFn createFn = creators.find(pluginId);
+		return createFn ? createFn(host) : nullptr;
+	}
+
+	static const clap_plugin_factory * factory() {
+		static const clap_plugin_factory factory{
+			.get_plugin_count=[](const clap_plugin_factory *) -> uint32_t {
+				return count;
+			},
+			.get_plugin_descriptor=[](const clap_plugin_factory *, uint32_t index) {
+				return descriptor(index);
+			},
+			.create_plugin=[](const clap_plugin_factory *, const clap_host *host, const char *pluginId) {
+				return create(host, pluginId);
+			}
+		};
+		return &factory;
+	}
+};
+
+}} // namespace
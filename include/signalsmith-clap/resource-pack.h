@@ -0,0 +1,241 @@
+#pragma once
+
+#include "./embedded-resources.h"
+#include "./id-table.h"
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#if defined(_WIN32)
+#	ifndef WIN32_LEAN_AND_MEAN
+#		define WIN32_LEAN_AND_MEAN
+#	endif
+#	ifndef NOMINMAX
+#		define NOMINMAX
+#	endif
+#	include <windows.h>
+#elif !defined(__EMSCRIPTEN__)
+#	include <fcntl.h>
+#	include <sys/mman.h>
+#	include <sys/stat.h>
+#	include <unistd.h>
+#endif
+
+namespace signalsmith { namespace clap {
+
+/* A single indexed archive of resources (written by `source/hxx-resources.py --pack`):
+
+	header: magic, version, entry count, offset of the entry table
+	entries: path/media-type string offsets, data offset and size (all from the start of the file)
+	strings: null-terminated
+	data: deduplicated, each 16-byte aligned
+
+It's memory-mapped read-only, so it's shared by all plugin instances (and the OS page cache), and resources are served straight out of the mapping.  Open it once (e.g. in `clap_entry.init()`) and close it after all plugins are destroyed.  Opening also builds a small hash table of the paths, so lookups don't scan the entries.
+
+Everything is in native (little-endian) byte order.
+*/
+struct ResourcePackHeader {
+	static constexpr uint32_t magicNumber = 0x50525353; // "SSRP"
+	static constexpr uint32_t currentVersion = 1;
+
+	uint32_t magic = magicNumber;
+	uint32_t version = currentVersion;
+	uint32_t entryCount = 0;
+	uint32_t entryOffset = 0;
+};
+struct ResourcePackEntry {
+	uint32_t pathOffset, mediaTypeOffset;
+	uint64_t dataOffset, size;
+};
+
+struct ResourcePack {
+	ResourcePack() {}
+	ResourcePack(const ResourcePack &other) = delete;
+	~ResourcePack() {
+		close();
+	}
+
+	bool open(const std::string &file) {
+		close();
+		if (!map(file)) return false;
+		if (!validate()) {
+			close();
+			return false;
+		}
+		return true;
+	}
+	void close() {
+		unmap();
+		mapped = nullptr;
+		mappedSize = 0;
+		header = nullptr;
+		entries = nullptr;
+		slots.clear();
+		hashes.clear();
+	}
+	bool isOpen() const {
+		return header;
+	}
+
+	size_t size() const {
+		return header ? header->entryCount : 0;
+	}
+	EmbeddedResource operator[](size_t index) const {
+		auto &entry = entries[index];
+		return {
+			(const char *)mapped + entry.pathOffset,
+			(const char *)mapped + entry.mediaTypeOffset,
+			mapped + entry.dataOffset,
+			size_t(entry.size)
+		};
+	}
+
+	// Resources are stored under a directory per plugin - the `path` is matched the same way as `findResource()`
+	bool find(const char *directory, const char *path, EmbeddedResource &result) const {
+		if (slots.empty()) return false;
+		while (*path == '/') ++path;
+		size_t pathLength = std::strlen(path);
+		// Directories (or an empty path) mean their `index.html`
+		const char *suffix = (!pathLength || path[pathLength - 1] == '/') ? "index.html" : "";
+
+		uint32_t hash = hashAppend(hashAppend(hashAppend(hashAppend(0x811C9DC5u, directory), "/"), path), suffix);
+		for (uint32_t slot = hash&slotMask; uint32_t index = slots[slot]; slot = (slot + 1)&slotMask) {
+			if (hashes[index - 1] != hash) continue;
+			auto resource = (*this)[index - 1];
+			const char *r = matchPrefix(resource.path, directory);
+			r = matchPrefix(r, "/");
+			r = matchPrefix(r, path);
+			if (r && !std::strcmp(r, suffix)) {
+				result = resource;
+				return true;
+			}
+		}
+		return false;
+	}
+
+private:
+	const unsigned char *mapped = nullptr;
+	size_t mappedSize = 0;
+	const ResourcePackHeader *header = nullptr;
+	const ResourcePackEntry *entries = nullptr;
+	// Open-addressed hash table of entry paths (FNV-1a), at least half empty
+	std::vector<uint32_t> slots; // index + 1, or 0 for empty
+	std::vector<uint32_t> hashes; // for each entry
+	uint32_t slotMask = 0;
+
+	static uint32_t hashAppend(uint32_t hash, const char *str) {
+		while (*str) {
+			hash ^= (unsigned char)*str++;
+			hash *= 0x01000193u;
+		}
+		return hash;
+	}
+	// Returns the rest of `str` after `prefix`, or `nullptr` if it doesn't start with it
+	static const char * matchPrefix(const char *str, const char *prefix) {
+		if (!str) return nullptr;
+		while (*prefix) {
+			if (*str++ != *prefix++) return nullptr;
+		}
+		return str;
+	}
+
+	void buildIndex() {
+		size_t slotCount = 2;
+		while (slotCount < size()*2) slotCount *= 2;
+		slots.assign(slotCount, 0);
+		slotMask = uint32_t(slotCount - 1);
+		hashes.resize(size());
+		for (size_t i = 0; i < size(); ++i) {
+			uint32_t hash = fnv1a((*this)[i].path);
+			hashes[i] = hash;
+			uint32_t slot = hash&slotMask;
+			while (slots[slot]) slot = (slot + 1)&slotMask;
+			slots[slot] = uint32_t(i + 1);
+		}
+	}
+
+	// Check every offset once, so lookups don't have to
+	bool validate() {
+		if (mappedSize < sizeof(ResourcePackHeader)) return false;
+		auto *h = (const ResourcePackHeader *)mapped;
+		if (h->magic != ResourcePackHeader::magicNumber || h->version != ResourcePackHeader::currentVersion) return false;
+		if (h->entryOffset%alignof(ResourcePackEntry) || h->entryOffset > mappedSize) return false;
+		if (h->entryCount > (mappedSize - h->entryOffset)/sizeof(ResourcePackEntry)) return false;
+		auto *e = (const ResourcePackEntry *)(mapped + h->entryOffset);
+		auto validString = [&](uint32_t offset){
+			return offset < mappedSize && std::memchr(mapped + offset, 0, mappedSize - offset);
+		};
+		for (uint32_t i = 0; i < h->entryCount; ++i) {
+			if (!validString(e[i].pathOffset) || !validString(e[i].mediaTypeOffset)) return false;
+			if (e[i].dataOffset > mappedSize || e[i].size > mappedSize - e[i].dataOffset) return false;
+		}
+		header = h;
+		entries = e;
+		buildIndex();
+		return true;
+	}
+
+#if defined(_WIN32)
+	HANDLE mapping = nullptr;
+
+	bool map(const std::string &file) {
+		int wideLength = MultiByteToWideChar(CP_UTF8, 0, file.c_str(), -1, nullptr, 0);
+		if (wideLength <= 0) return false;
+		std::wstring wideFile(size_t(wideLength), L'\0');
+		MultiByteToWideChar(CP_UTF8, 0, file.c_str(), -1, &wideFile[0], wideLength);
+
+		HANDLE handle = CreateFileW(wideFile.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (handle == INVALID_HANDLE_VALUE) return false;
+		LARGE_INTEGER fileSize;
+		if (!GetFileSizeEx(handle, &fileSize) || fileSize.QuadPart <= 0) {
+			CloseHandle(handle);
+			return false;
+		}
+		mapping = CreateFileMappingW(handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		CloseHandle(handle); // the mapping keeps the file open
+		if (!mapping) return false;
+		mapped = (const unsigned char *)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+		if (!mapped) {
+			CloseHandle(mapping);
+			mapping = nullptr;
+			return false;
+		}
+		mappedSize = size_t(fileSize.QuadPart);
+		return true;
+	}
+	void unmap() {
+		if (mapped) UnmapViewOfFile(mapped);
+		if (mapping) CloseHandle(mapping);
+		mapping = nullptr;
+	}
+#elif defined(__EMSCRIPTEN__)
+	// No bundle directory to load from - WCLAP builds use the embedded resources instead
+	bool map(const std::string &) {
+		return false;
+	}
+	void unmap() {}
+#else
+	bool map(const std::string &file) {
+		int fd = ::open(file.c_str(), O_RDONLY);
+		if (fd < 0) return false;
+		struct stat fileStat;
+		if (fstat(fd, &fileStat) != 0 || fileStat.st_size <= 0) {
+			::close(fd);
+			return false;
+		}
+		void *ptr = mmap(nullptr, size_t(fileStat.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+		::close(fd); // the mapping keeps the file open
+		if (ptr == MAP_FAILED) return false;
+		mapped = (const unsigned char *)ptr;
+		mappedSize = size_t(fileStat.st_size);
+		return true;
+	}
+	void unmap() {
+		if (mapped) munmap((void *)mapped, mappedSize);
+	}
+#endif
+};
+
+}} // namespace
@@ -0,0 +1,202 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#if defined(__has_include)
+#	if __has_include(<execinfo.h>)
+#		include <execinfo.h>
+#		define SIGNALSMITH_CLAP_RT_GUARD_BACKTRACE 1
+#	endif
+#endif
+
+namespace signalsmith { namespace clap {
+
+/* Debug-build detector for allocations and (blocking) mutex locks on the audio thread.
+
+While a `RtGuard::Scope` is alive, the current thread is "armed", and any allocation, free or `pthread_mutex_lock()` counts as a violation.  Violations are counted (globally, and in an optional per-scope counter) and the first few print a backtrace to stderr.  If the `SIGNALSMITH_CLAP_RT_GUARD` environment variable is `abort`, the first one aborts instead.
+
+The hooks themselves are only compiled in one translation unit, which defines `SIGNALSMITH_CLAP_RT_GUARD_IMPLEMENTATION` before including this.  They need help from the linker:
+	* Linux (GNU ld/lld): link with `--wrap=` for each of `malloc`, `calloc`, `realloc`, `free`, `pthread_mutex_lock`, and the mangled `operator new`/`delete`s (see `CMakeLists.txt`).  This catches everything the plugin's own code calls.
+	* Apple: replacement `operator new`/`delete` only, since `ld64` has no `--wrap`.  So direct `malloc()`/`free()` calls and mutex locks are *not* caught there.
+	* Elsewhere: nothing is hooked, but `Scope`s are harmless.
+*/
+struct RtGuard {
+	static constexpr int maxBacktraces = 10;
+
+	struct Counters {
+		std::atomic<uint64_t> allocations{0}, locks{0};
+	};
+	static Counters & counters() {
+		static Counters c;
+		return c;
+	}
+
+	struct Scope {
+		// These are incremented as well as the global counts (e.g. `&perfStats.audioThreadAllocations`)
+		Scope(std::atomic<uint64_t> *allocationCounter=nullptr, std::atomic<uint64_t> *lockCounter=nullptr) {
+			auto &state = threadState();
+			prevAllocations = state.allocations;
+			prevLocks = state.locks;
+			state.allocations = allocationCounter;
+			state.locks = lockCounter;
+			++state.depth;
+		}
+		~Scope() {
+			auto &state = threadState();
+			--state.depth;
+			state.allocations = prevAllocations;
+			state.locks = prevLocks;
+		}
+		Scope(const Scope &other) = delete;
+	private:
+		std::atomic<uint64_t> *prevAllocations, *prevLocks;
+	};
+
+	static bool armed() {
+		return threadState().depth > 0;
+	}
+
+	// Called by the hooks.  `what` should be a string literal.
+	static void violation(const char *what, bool isLock=false) {
+		auto &state = threadState();
+		if (state.depth <= 0) return;
+		int depth = state.depth;
+		state.depth = 0; // disarm while we report, since that might allocate
+
+		auto &c = counters();
+		uint64_t count = 1 + (isLock ? c.locks : c.allocations).fetch_add(1, std::memory_order_relaxed);
+		if (auto *counter = (isLock ? state.locks : state.allocations)) counter->fetch_add(1, std::memory_order_relaxed);
+
+		bool shouldAbort = abortOnViolation();
+		if (shouldAbort || count <= maxBacktraces) {
+			std::fprintf(stderr, "real-time violation on audio thread: %s\n", what);
+#ifdef SIGNALSMITH_CLAP_RT_GUARD_BACKTRACE
+			void *frames[64];
+			int frameCount = backtrace(frames, 64);
+			backtrace_symbols_fd(frames, frameCount, 2);
+#endif
+			if (shouldAbort) std::abort();
+		}
+		state.depth = depth;
+	}
+
+private:
+	struct ThreadState {
+		int depth;
+		std::atomic<uint64_t> *allocations, *locks;
+	};
+	// Trivial `thread_local`, so (unlike a `thread_local` object) it can be used from inside `malloc()`
+	static ThreadState & threadState() {
+		static thread_local ThreadState state{0, nullptr, nullptr};
+		return state;
+	}
+
+	static bool abortOnViolation() {
+		static const bool value = [](){
+			const char *env = std::getenv("SIGNALSMITH_CLAP_RT_GUARD");
+			return env && !std::strcmp(env, "abort");
+		}();
+		return value;
+	}
+};
+
+}} // namespace
+
+#ifdef SIGNALSMITH_CLAP_RT_GUARD_IMPLEMENTATION
+#include <new>
+
+#if defined(__linux__)
+#include <pthread.h>
+
+extern "C" {
+	void * __real_malloc(size_t size);
+	void * __real_calloc(size_t count, size_t size);
+	void * __real_realloc(void *ptr, size_t size);
+	void __real_free(void *ptr);
+	int __real_pthread_mutex_lock(pthread_mutex_t *mutex);
+	void * __real__Znwm(size_t size);
+	void * __real__Znam(size_t size);
+	void __real__ZdlPv(void *ptr);
+	void __real__ZdaPv(void *ptr);
+	void __real__ZdlPvm(void *ptr, size_t size);
+	void __real__ZdaPvm(void *ptr, size_t size);
+
+	void * __wrap_malloc(size_t size) {
+		signalsmith::clap::RtGuard::violation("malloc()");
+		return __real_malloc(size);
+	}
+	void * __wrap_calloc(size_t count, size_t size) {
+		signalsmith::clap::RtGuard::violation("calloc()");
+		return __real_calloc(count, size);
+	}
+	void * __wrap_realloc(void *ptr, size_t size) {
+		signalsmith::clap::RtGuard::violation("realloc()");
+		return __real_realloc(ptr, size);
+	}
+	void __wrap_free(void *ptr) {
+		if (ptr) signalsmith::clap::RtGuard::violation("free()");
+		__real_free(ptr);
+	}
+	int __wrap_pthread_mutex_lock(pthread_mutex_t *mutex) {
+		signalsmith::clap::RtGuard::violation("pthread_mutex_lock()", true);
+		return __real_pthread_mutex_lock(mutex);
+	}
+	void * __wrap__Znwm(size_t size) {
+		signalsmith::clap::RtGuard::violation("operator new");
+		return __real__Znwm(size);
+	}
+	void * __wrap__Znam(size_t size) {
+		signalsmith::clap::RtGuard::violation("operator new[]");
+		return __real__Znam(size);
+	}
+	void __wrap__ZdlPv(void *ptr) {
+		if (ptr) signalsmith::clap::RtGuard::violation("operator delete");
+		__real__ZdlPv(ptr);
+	}
+	void __wrap__ZdaPv(void *ptr) {
+		if (ptr) signalsmith::clap::RtGuard::violation("operator delete[]");
+		__real__ZdaPv(ptr);
+	}
+	void __wrap__ZdlPvm(void *ptr, size_t size) {
+		if (ptr) signalsmith::clap::RtGuard::violation("operator delete");
+		__real__ZdlPvm(ptr, size);
+	}
+	void __wrap__ZdaPvm(void *ptr, size_t size) {
+		if (ptr) signalsmith::clap::RtGuard::violation("operator delete[]");
+		__real__ZdaPvm(ptr, size);
+	}
+}
+
+#elif defined(__APPLE__)
+
+void * operator new(size_t size) {
+	signalsmith::clap::RtGuard::violation("operator new");
+	if (void *ptr = std::malloc(size ? size : 1)) return ptr;
+	throw std::bad_alloc{};
+}
+void * operator new[](size_t size) {
+	signalsmith::clap::RtGuard::violation("operator new[]");
+	if (void *ptr = std::malloc(size ? size : 1)) return ptr;
+	throw std::bad_alloc{};
+}
+void operator delete(void *ptr) noexcept {
+	if (ptr) signalsmith::clap::RtGuard::violation("operator delete");
+	std::free(ptr);
+}
+void operator delete[](void *ptr) noexcept {
+	if (ptr) signalsmith::clap::RtGuard::violation("operator delete[]");
+	std::free(ptr);
+}
+void operator delete(void *ptr, size_t) noexcept {
+	operator delete(ptr);
+}
+void operator delete[](void *ptr, size_t) noexcept {
+	operator delete[](ptr);
+}
+
+#endif
+#endif // SIGNALSMITH_CLAP_RT_GUARD_IMPLEMENTATION
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "clap/audio-buffer.h"
+
+#include <algorithm>
+#include <cstdint>
+
+namespace signalsmith { namespace clap {
+
+/* Helpers for skipping work on silent audio, and passing that on to the host.
+
+	if (isSilent(process->audio_inputs[0], process->frames_count)) ...
+	writeSilence(process->audio_outputs[0], process->frames_count); // zeros, and sets `constant_mask`
+
+Hosts don't have to set `constant_mask` even when they know, so we check the samples for any channel which isn't flagged.  That's cheap next to any actual processing.
+*/
+template<class Sample>
+bool isSilent(Sample * const *channels, uint32_t channelCount, uint64_t constantMask, uint32_t frames) {
+	if (!frames) return true;
+	for (uint32_t c = 0; c < channelCount; ++c) {
+		auto *channel = channels[c];
+		// Constant channels have the same value throughout
+		bool constant = (c < 64) && (constantMask&(uint64_t(1)<<c));
+		uint32_t end = constant ? 1 : frames;
+		for (uint32_t i = 0; i < end; ++i) {
+			if (channel[i] != 0) return false;
+		}
+	}
+	return true;
+}
+inline bool isSilent(const clap_audio_buffer &buffer, uint32_t frames) {
+	if (buffer.data32) return isSilent(buffer.data32, buffer.channel_count, buffer.constant_mask, frames);
+	if (buffer.data64) return isSilent(buffer.data64, buffer.channel_count, buffer.constant_mask, frames);
+	return true;
+}
+
+inline uint64_t allChannelsMask(uint32_t channelCount) {
+	return (channelCount >= 64) ? ~uint64_t(0) : (uint64_t(1)<<channelCount) - 1;
+}
+
+inline void writeSilence(clap_audio_buffer &buffer, uint32_t frames) {
+	for (uint32_t c = 0; c < buffer.channel_count; ++c) {
+		if (buffer.data32) std::fill(buffer.data32[c], buffer.data32[c] + frames, 0.0f);
+		if (buffer.data64) std::fill(buffer.data64[c], buffer.data64[c] + frames, 0.0);
+	}
+	buffer.constant_mask = allChannelsMask(buffer.channel_count);
+}
+
+}} // namespace
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <atomic>
+#include <array>
+#include <cstddef>
+
+namespace signalsmith { namespace clap {
+
+/* A fixed-capacity single-producer single-consumer queue, which never allocates, locks or waits.
+
+One thread can `.push()` while another thread `.pop()`s.  If the queue is full, `.push()` returns `false` and it's up to the caller what to do about it.
+*/
+template<class Item, size_t capacity>
+struct SpscQueue {
+	static_assert(capacity > 0 && (capacity&(capacity - 1)) == 0, "capacity must be a power of 2");
+
+	// Producer thread only
+	bool push(const Item &item) {
+		size_t w = writeIndex.load(std::memory_order_relaxed);
+		if (w - readIndex.load(std::memory_order_acquire) >= capacity) return false;
+		items[w&(capacity - 1)] = item;
+		writeIndex.store(w + 1, std::memory_order_release);
+		return true;
+	}
+
+	// Consumer thread only
+	bool pop(Item &item) {
+		size_t r = readIndex.load(std::memory_order_relaxed);
+		if (r == writeIndex.load(std::memory_order_acquire)) return false;
+		item = items[r&(capacity - 1)];
+		readIndex.store(r + 1, std::memory_order_release);
+		return true;
+	}
+	// Consumer thread only - drops everything currently in the queue
+	void clear() {
+		readIndex.store(writeIndex.load(std::memory_order_acquire), std::memory_order_release);
+	}
+
+	// Approximate if called while the other thread is active
+	size_t size() const {
+		return writeIndex.load(std::memory_order_acquire) - readIndex.load(std::memory_order_acquire);
+	}
+	bool empty() const {
+		return size() == 0;
+	}
+
+private:
+	std::array<Item, capacity> items;
+	// on separate cache-lines, so the two threads don't fight over them
+	alignas(64) std::atomic<size_t> writeIndex{0};
+	alignas(64) std::atomic<size_t> readIndex{0};
+};
+
+}} // namespace
@@ -0,0 +1,131 @@
+#pragma once
+
+#include "./spsc-queue.h"
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <thread>
+
+namespace signalsmith { namespace clap {
+
+/* A pool of SPSC queues, one per producer thread, so any number of threads can push without locking or waiting.
+
+Each thread claims a ring the first time it pushes, and releases it when the thread exits (once the consumer has read everything left in it, the ring can be claimed again).  If they're all taken, pushes from other threads are dropped, and counted by `.takeUnclaimedDropped()`.  A single consumer reads them all with `.forEachRing()`.
+
+Claiming a ring also registers a `thread_local` destructor, which might allocate - but only once per thread, and only if anything's being recorded.
+
+The rings are allocated by `.allocate()`, which should be called before anything pushes (not from the audio thread), and they're never freed until the pool is destroyed.  The per-thread ring is a `thread_local` shared by all pools of the same type, so there should only be one (e.g. a singleton).
+*/
+template<class Item, size_t capacity, size_t maxThreads=32>
+struct ThreadRings {
+	struct Ring {
+		std::atomic<bool> claimed{false};
+		std::atomic<bool> released{false}; // the thread has exited, so it can be re-used once it's empty
+		std::atomic<uint64_t> threadId{0};
+		std::atomic<uint64_t> dropped{0};
+		uint64_t droppedReported = 0; // consumer only
+		SpscQueue<Item, capacity> items;
+
+		// Consumer only: how many were dropped since the last call
+		uint64_t takeDropped() {
+			uint64_t total = dropped.load(std::memory_order_relaxed);
+			uint64_t result = total - droppedReported;
+			droppedReported = total;
+			return result;
+		}
+	};
+
+	// Not real-time safe, but can be called more than once
+	void allocate() {
+		if (!allocated.load(std::memory_order_acquire)) {
+			rings.reset(new Ring[maxThreads]);
+			allocated.store(true, std::memory_order_release);
+		}
+	}
+
+	// Any thread: returns `false` if the item was dropped
+	bool push(const Item &item) {
+		auto *ring = threadRing();
+		if (!ring) ring = claimRing();
+		if (!ring) {
+			if (allocated.load(std::memory_order_relaxed)) unclaimedDropped.fetch_add(1, std::memory_order_relaxed);
+			return false;
+		}
+		if (ring->items.push(item)) return true;
+		ring->dropped.fetch_add(1, std::memory_order_relaxed);
+		return false;
+	}
+
+	// How full the calling thread's ring is (0 if it doesn't have one)
+	size_t threadFill() const {
+		auto *ring = threadRing();
+		return ring ? ring->items.size() : 0;
+	}
+
+	// Consumer only
+	template<class Fn>
+	void forEachRing(Fn &&fn) {
+		if (!allocated.load(std::memory_order_acquire)) return;
+		for (size_t i = 0; i < maxThreads; ++i) {
+			auto &ring = rings[i];
+			if (!ring.claimed.load(std::memory_order_acquire)) continue;
+			bool released = ring.released.load(std::memory_order_acquire);
+			fn(ring);
+			// The thread's gone, and we've read everything it pushed, so someone else can have it
+			if (released && ring.items.empty()) {
+				ring.released.store(false, std::memory_order_relaxed);
+				ring.claimed.store(false, std::memory_order_release);
+				freeRings.fetch_add(1, std::memory_order_release);
+			}
+		}
+	}
+	// Consumer only: pushes dropped since the last call, because there was no ring free
+	uint64_t takeUnclaimedDropped() {
+		uint64_t total = unclaimedDropped.load(std::memory_order_relaxed);
+		uint64_t result = total - unclaimedReported;
+		unclaimedReported = total;
+		return result;
+	}
+
+private:
+	std::atomic<bool> allocated{false};
+	std::unique_ptr<Ring[]> rings;
+	std::atomic<size_t> freeRings{maxThreads};
+	std::atomic<uint64_t> unclaimedDropped{0};
+	uint64_t unclaimedReported = 0; // consumer only
+
+	// Trivial `thread_local` (no destructor), so checking it never allocates
+	static Ring *& threadRing() {
+		static thread_local Ring *ring = nullptr;
+		return ring;
+	}
+	// Releases the thread's ring when it exits
+	struct ThreadReleaser {
+		Ring *ring = nullptr;
+		~ThreadReleaser() {
+			if (ring) ring->released.store(true, std::memory_order_release);
+			threadRing() = nullptr;
+		}
+	};
+
+	Ring * claimRing() {
+		// Cheap check first, so threads without a ring don't keep scanning
+		if (!allocated.load(std::memory_order_acquire) || !freeRings.load(std::memory_order_acquire)) return nullptr;
+		for (size_t i = 0; i < maxThreads; ++i) {
+			bool expected = false;
+			if (rings[i].claimed.compare_exchange_strong(expected, true, std::memory_order_acq_rel)) {
+				freeRings.fetch_sub(1, std::memory_order_relaxed);
+				rings[i].threadId.store(uint64_t(std::hash<std::thread::id>{}(std::this_thread::get_id())), std::memory_order_release);
+				static thread_local ThreadReleaser releaser;
+				releaser.ring = &rings[i];
+				threadRing() = &rings[i];
+				return &rings[i];
+			}
+		}
+		return nullptr;
+	}
+};
+
+}} // namespace
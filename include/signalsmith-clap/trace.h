@@ -0,0 +1,146 @@
+#pragma once
+
+#include "./thread-rings.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <string>
+
+namespace signalsmith { namespace clap {
+
+/* Records timed spans from any thread (including the audio thread), and writes them out as a Chrome trace (JSON), which can be opened in Perfetto or `chrome://tracing`.
+
+Each thread gets its own fixed-size ring (claimed from a pool the first time it records), so recording never locks or allocates.  The rings are drained to the file from the main thread.  If a ring fills up before that, new spans are dropped (and counted).
+
+It's off unless `.start()` is called - `TraceSpan` just checks a flag in that case.
+
+	// in clap_entry.init()
+	Trace::instance().startFromEnvironment("SIGNALSMITH_CLAP_TRACE");
+
+	// anywhere - name must be a string literal (or otherwise live forever)
+	TraceSpan span{"chorus.process"};
+
+	// on the main thread, every so often
+	Trace::instance().drain();
+*/
+struct Trace {
+	static constexpr size_t maxThreads = 32;
+	static constexpr size_t eventsPerThread = 8192;
+
+	struct Event {
+		const char *name;
+		uint64_t startNs, durationNs;
+	};
+
+	static Trace & instance() {
+		static Trace trace;
+		return trace;
+	}
+
+	bool enabled() const {
+		return active.load(std::memory_order_relaxed);
+	}
+
+	// Main thread.  Starts writing to `path` (if the environment variable is set and non-empty)
+	bool startFromEnvironment(const char *envVar) {
+		const char *path = std::getenv(envVar);
+		if (!path || !*path) return false;
+		return start(path);
+	}
+	bool start(const std::string &path) {
+		std::lock_guard<std::mutex> guard{drainMutex};
+		if (file) return true;
+		file = std::fopen(path.c_str(), "w");
+		if (!file) return false;
+		std::fputs("[\n", file);
+		firstEvent = true;
+		// Allocated once and never freed (until exit), so a thread still finishing a span can't write to freed memory
+		rings.allocate();
+		active.store(true, std::memory_order_release);
+		return true;
+	}
+	// Main thread - drains everything and closes the file
+	void stop() {
+		active.store(false, std::memory_order_release);
+		std::lock_guard<std::mutex> guard{drainMutex};
+		if (!file) return;
+		drainLocked();
+		std::fputs("\n]\n", file);
+		std::fclose(file);
+		file = nullptr;
+	}
+
+	// Main thread
+	void drain() {
+		if (!enabled()) return;
+		std::lock_guard<std::mutex> guard{drainMutex};
+		drainLocked();
+	}
+	// Any thread: true if a ring is filling up, so it's worth asking for a main-thread callback
+	bool needsDrain() const {
+		return enabled() && rings.threadFill() > eventsPerThread/2;
+	}
+
+	// Any thread (real-time safe)
+	void record(const char *name, uint64_t startNs, uint64_t endNs) {
+		rings.push({name, startNs, endNs - startNs});
+	}
+
+	uint64_t nowNs() const {
+		return uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - startTime).count());
+	}
+
+private:
+	std::atomic<bool> active{false};
+	ThreadRings<Event, eventsPerThread, maxThreads> rings;
+	std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+
+	std::mutex drainMutex;
+	std::FILE *file = nullptr;
+	bool firstEvent = true;
+
+	void drainLocked() {
+		if (!file) return;
+		Event event;
+		rings.forEachRing([&](auto &ring){
+			unsigned long long tid = ring.threadId.load(std::memory_order_acquire)%0x7FFFFFFF;
+			while (ring.items.pop(event)) {
+				std::fprintf(file, "%s{\"name\":\"%s\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%llu}", firstEvent ? "" : ",\n", event.name, event.startNs*1e-3, event.durationNs*1e-3, tid);
+				firstEvent = false;
+			}
+			if (uint64_t dropped = ring.takeDropped()) {
+				// An instant event, so it's visible in the timeline
+				std::fprintf(file, "%s{\"name\":\"dropped %llu spans\",\"ph\":\"i\",\"s\":\"t\",\"ts\":%.3f,\"pid\":1,\"tid\":%llu}", firstEvent ? "" : ",\n", (unsigned long long)dropped, nowNs()*1e-3, tid);
+				firstEvent = false;
+			}
+		});
+		if (uint64_t dropped = rings.takeUnclaimedDropped()) {
+			std::fprintf(file, "%s{\"name\":\"dropped %llu spans from threads without a ring\",\"ph\":\"i\",\"s\":\"g\",\"ts\":%.3f,\"pid\":1,\"tid\":0}", firstEvent ? "" : ",\n", (unsigned long long)dropped, nowNs()*1e-3);
+			firstEvent = false;
+		}
+		std::fflush(file);
+	}
+};
+
+// Records a span from construction to destruction
+struct TraceSpan {
+	TraceSpan(const char *name) : name(name) {
+		if (Trace::instance().enabled()) startNs = Trace::instance().nowNs();
+	}
+	~TraceSpan() {
+		auto &trace = Trace::instance();
+		if (startNs != notStarted && trace.enabled()) trace.record(name, startNs, trace.nowNs());
+	}
+	TraceSpan(const TraceSpan &other) = delete;
+
+private:
+	static constexpr uint64_t notStarted = uint64_t(-1);
+	const char *name;
+	uint64_t startNs = notStarted;
+};
+
+}} // namespace
@@ -1,26 +1,22 @@
 #include "example-audio-plugin.h"
 
-namespace example_audio_plugin_resources {
-#include "./resources/index.html.hxx"
-#include "./resources/cbor.min.js.hxx"
-};
+#ifdef EMBED_RESOURCES
+#	include "embedded-resources.hxx"
+#endif
 
 bool ExampleAudioPlugin::webviewGetResource(const char *path, WebviewGui::Resource &resource) {
-	using namespace example_audio_plugin_resources;
-	if (!std::strcmp(path, "/")) {
-		resource.mediaType = "text/html";
-		resource.bytes.assign(
-			(const unsigned char *)index_html,
-			(const unsigned char *)index_html + sizeof(index_html)
-		);
-		return true;
-	} else if (!std::strcmp(path, "/cbor.min.js")) {
-		resource.mediaType = "application/javascript";
-		resource.bytes.assign(
-			(const unsigned char *)cbor_min_js,
-			(const unsigned char *)cbor_min_js + sizeof(cbor_min_js)
-		);
-		return true;
+	signalsmith::clap::EmbeddedResource found;
+	if (!clapResourcePack.find("example-audio-plugin", path, found)) {
+#ifdef EMBED_RESOURCES
+		auto *embedded = signalsmith::clap::findResource(embedded_resources::example_audio_plugin, path);
+		if (!embedded) return false;
+		found = *embedded;
+#else
+		return false;
+#endif
 	}
-	return false;
+	resource.mediaType = found.mediaType;
+	// `WebviewGui::Resource` owns its bytes, so this is the only copy
+	resource.bytes.assign(found.data, found.data + found.size);
+	return true;
 }
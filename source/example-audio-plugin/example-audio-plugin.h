@@ -1,19 +1,30 @@
 #ifndef LOG_EXPR
-#	include <iostream>
-#	define LOG_EXPR(expr) std::cout << #expr " = " << (expr) << std::endl;
+#	include "signalsmith-clap/log.h"
+#	define LOG_EXPR(expr) SIGNALSMITH_CLAP_LOG_EXPR(expr)
 #endif
 
 #include "clap/clap.h"
 
 #include "signalsmith-clap/cpp.h"
+#include "signalsmith-clap/id-table.h"
+#include "signalsmith-clap/instrument.h"
+#include "signalsmith-clap/params.h"
+#include "signalsmith-clap/perf-stats.h"
+#include "signalsmith-clap/param-state.h"
+#include "signalsmith-clap/silence.h"
+#include "signalsmith-clap/trace.h"
 
 #include "signalsmith-basics/chorus.h"
 #include "cbor-walker/cbor-walker.h"
 #include "webview-gui/webview-gui.h"
 
 #include "../plugins.h"
+#include "./webview-pool.h"
 
+#include <algorithm>
 #include <atomic>
+#include <cmath>
+#include <vector>
 
 struct ExampleAudioPlugin {
 	using Plugin = ExampleAudioPlugin;
@@ -51,106 +62,43 @@ struct ExampleAudioPlugin {
 
 	signalsmith::basics::ChorusFloat chorus;
 
-	struct Param {
-		double value = 0;
-		clap_param_info info;
-		const char *formatString = "%.2f";
-		
-		// User interactions which we need to send as events to the host
-		std::atomic_flag sentValue = ATOMIC_FLAG_INIT;
-		std::atomic_flag sentGestureStart = ATOMIC_FLAG_INIT;
-		std::atomic_flag sentGestureEnd =ATOMIC_FLAG_INIT;
-
-		std::atomic_flag sentUiState = ATOMIC_FLAG_INIT;
-
-		Param(const char *name, clap_id paramId, double min, double initial, double max) : value(initial) {
-			info = {
-				.id=paramId,
-				.flags=CLAP_PARAM_IS_AUTOMATABLE,
-				.cookie=this,
-				.name={}, // assigned below
-				.module={},
-				.min_value=min,
-				.max_value=max,
-				.default_value=initial
-			};
-			std::strncpy(info.name, name, CLAP_NAME_SIZE);
-			
-			sentValue.test_and_set();
-			sentGestureStart.test_and_set();
-			sentGestureEnd.test_and_set();
-		}
-
-		void sendEvents(const clap_output_events *outEvents) {
-			if (!sentGestureStart.test_and_set()) {
-				clap_event_param_gesture event{
-					.header={
-						.size=sizeof(clap_event_param_gesture),
-						.time=0,
-						.space_id=CLAP_CORE_EVENT_SPACE_ID,
-						.type=CLAP_EVENT_PARAM_GESTURE_BEGIN,
-						.flags=CLAP_EVENT_IS_LIVE
-					},
-					.param_id=info.id
-				};
-				outEvents->try_push(outEvents, &event.header);
-			}
-			if (!sentValue.test_and_set()) {
-				clap_event_param_value event{
-					.header={
-						.size=sizeof(clap_event_param_value),
-						.time=0,
-						.space_id=CLAP_CORE_EVENT_SPACE_ID,
-						.type=CLAP_EVENT_PARAM_VALUE,
-						.flags=CLAP_EVENT_IS_LIVE
-					},
-					.param_id=info.id,
-					.cookie=this,
-					.note_id=-1,
-					.port_index=-1,
-					.channel=-1,
-					.key=-1,
-					.value=value
-				};
-				outEvents->try_push(outEvents, &event.header);
-			}
-			if (!sentGestureEnd.test_and_set()) {
-				clap_event_param_gesture event{
-					.header={
-						.size=sizeof(clap_event_param_gesture),
-						.time=0,
-						.space_id=CLAP_CORE_EVENT_SPACE_ID,
-						.type=CLAP_EVENT_PARAM_GESTURE_END,
-						.flags=CLAP_EVENT_IS_LIVE
-					},
-					.param_id=info.id
-				};
-				outEvents->try_push(outEvents, &event.header);
-			}
-		}
-	};
-	Param mix{"mix", 0xCA5CADE5, 0, 0.6, 1};
-	Param depthMs{"depth", 0xBA55FEED, 2, 15, 50};
-	Param detune{"detune", 0xCA55E77E, 1, 6, 30};
-	Param stereo{"stereo", 0x0FF51DE5, 0, 1, 2};
-	std::array<Param *, 4> params = {&mix, &depthMs, &detune, &stereo};
+	using Param = signalsmith::clap::Param;
+	Param mix{"mix", "mix", 0xCA5CADE5, 0, 0.6, 1};
+	Param depthMs{"depth", "depth", 0xBA55FEED, 2, 15, 50};
+	Param detune{"detune", "detune", 0xCA55E77E, 1, 6, 30};
+	Param stereo{"stereo", "stereo", 0x0FF51DE5, 0, 1, 2};
+	Param bypass{"bypass", "bypass", 0xB1FA55ED, 0, 0, 1};
+	signalsmith::clap::ParamRegistry params{&mix, &depthMs, &detune, &stereo, &bypass};
 	
 	ExampleAudioPlugin(const clap_host *host) : host(host) {
 		depthMs.formatString = "%.1f ms";
 		detune.formatString = "%.0f cents";
+		bypass.info.flags |= CLAP_PARAM_IS_STEPPED|CLAP_PARAM_IS_BYPASS;
+		bypass.formatFn = [](double value){
+			return std::string(value >= 0.5 ? "bypassed" : "active");
+		};
 	}
 
-	// Makes a C function pointer to a C++ method
+	signalsmith::clap::PerfStats perfStats;
+#ifdef SIGNALSMITH_CLAP_INSTRUMENT
+	signalsmith::clap::Instrumentation instrumentation;
+#endif
+
+	// Makes a C function pointer to a C++ method (timing each call, checking `process()` for allocations, or capturing its events, if enabled)
 	template<auto methodPtr>
-	auto clapPluginMethod() -> decltype(signalsmith::clap::pluginMethod<methodPtr>()) {
+	static constexpr auto clapPluginMethod() -> decltype(signalsmith::clap::pluginMethod<methodPtr>()) {
+#if defined(SIGNALSMITH_CLAP_INSTRUMENT) || defined(SIGNALSMITH_CLAP_RT_GUARD) || defined(SIGNALSMITH_CLAP_CAPTURE)
+		return signalsmith::clap::instrumentedPluginMethod<methodPtr>();
+#else
 		return signalsmith::clap::pluginMethod<methodPtr>();
+#endif
 	}
 
 	const clap_plugin clapPlugin{
 		.desc=getPluginDescriptor(),
 		.plugin_data=this,
 		.init=clapPluginMethod<&Plugin::pluginInit>(),
-		.destroy=clapPluginMethod<&Plugin::pluginDestroy>(),
+		.destroy=signalsmith::clap::pluginDestroyMethod<&Plugin::pluginDestroy>(), // not timed, since it deletes the instance
 		.activate=clapPluginMethod<&Plugin::pluginActivate>(),
 		.deactivate=clapPluginMethod<&Plugin::pluginDeactivate>(),
 		.start_processing=clapPluginMethod<&Plugin::pluginStartProcessing>(),
@@ -174,6 +122,18 @@ struct ExampleAudioPlugin {
 	}
 	bool pluginActivate(double sRate, uint32_t minFrames, uint32_t maxFrames) {
 		chorus.configure(sRate, maxFrames, 2);
+		// The longest delay is the maximum depth, plus a bit for the modulation
+		tailSamples = uint32_t(std::ceil((depthMs.info.max_value + 10)*0.001*sRate));
+		silentSamples = tailSamples; // freshly configured, so nothing to ring out
+
+		maxBlock = maxFrames;
+		fadeStep = float(1/(0.01*sRate)); // 10ms
+		history.assign(2, std::vector<float>(tailSamples, 0));
+		historyPos = 0;
+		dryCopy.assign(2, std::vector<double>(maxFrames));
+		refillOutput.assign(2, std::vector<float>(maxFrames));
+		wetFade = isDry() ? 0 : 1;
+		refilling = false;
 		return true;
 	}
 	void pluginDeactivate() {
@@ -185,25 +145,18 @@ struct ExampleAudioPlugin {
 	}
 	void pluginReset() {
 		chorus.reset();
+		silentSamples = tailSamples;
+		for (auto &channel : history) std::fill(channel.begin(), channel.end(), 0);
+		wetFade = isDry() ? 0 : 1;
+		refilling = false;
 	}
 	void processEvent(const clap_event_header *event) {
+		signalsmith::clap::TraceSpan span{"processEvent"};
 		if (event->space_id != CLAP_CORE_EVENT_SPACE_ID) return;
 		if (event->type == CLAP_EVENT_PARAM_VALUE) {
 			auto &eventParam = *(const clap_event_param_value *)event;
-			if (eventParam.cookie) {
-				// if provided, it's the parameter
-				auto &param = *(Param *)eventParam.cookie;
-				param.value = eventParam.value;
-				param.sentUiState.clear();
-			} else {
-				// Otherwise, match the ID
-				for (auto *param : params) {
-					if (eventParam.param_id == param->info.id) {
-						param->value = eventParam.value;
-						param->sentUiState.clear();
-						break;
-					}
-				}
+			if (auto *param = params.find(eventParam)) {
+				param->setValueFromEvent(eventParam);
 			}
 
 			// Request a callback so we can tell the host our state is dirty
@@ -218,7 +171,9 @@ struct ExampleAudioPlugin {
 		auto &audioOutput = process->audio_outputs[0];
 
 		auto *eventsIn = process->in_events;
-		auto *eventsOut = process->out_events;
+		// Counts any events the host doesn't accept
+		signalsmith::clap::CountingOutputEvents countingEventsOut{process->out_events, perfStats.droppedEvents};
+		auto *eventsOut = &countingEventsOut;
 		uint32_t eventCount = eventsIn->size(eventsIn);
 		// We could (should?) split the processing up and apply these events partway through the block
 		// but for simplicity here we don't support sample-accurate automation
@@ -228,17 +183,152 @@ struct ExampleAudioPlugin {
 			eventsOut->try_push(eventsOut, event);
 		}
 		
+		for (auto *param : params) {
+			param->sendEvents(eventsOut);
+		}
+		if (signalsmith::clap::Trace::instance().needsDrain()) host->request_callback(host);
+
+		// Once the input's been silent for longer than our tail, the output is silent too
+		bool tailEnds = false;
+		if (!signalsmith::clap::isSilent(audioInput, process->frames_count)) {
+			silentSamples = 0;
+		} else if (silentSamples >= tailSamples) {
+			if (!sleeping) fallAsleep();
+			signalsmith::clap::writeSilence(audioOutput, process->frames_count);
+			return CLAP_PROCESS_SLEEP;
+		} else {
+			silentSamples = uint32_t(std::min<uint64_t>(uint64_t(silentSamples) + process->frames_count, tailSamples));
+			tailEnds = (silentSamples >= tailSamples);
+		}
+		sleeping = false;
+
+		// We declare `CLAP_AUDIO_PORT_SUPPORTS_64BITS`, so the host can give us either (but the same for input and output)
+		if (audioOutput.data64) {
+			processSamples<double>(audioInput, audioOutput, process->frames_count);
+		} else {
+			processSamples<float>(audioInput, audioOutput, process->frames_count);
+		}
+		if (tailEnds) {
+			// The tail finished during this block, so we can sleep already
+			fallAsleep();
+			return CLAP_PROCESS_SLEEP;
+		}
+		return CLAP_PROCESS_CONTINUE;
+	}
+
+	// The chorus itself stays `float` inside, but reads/writes either sample type directly
+	template<class Sample>
+	void processSamples(const clap_audio_buffer &audioInput, clap_audio_buffer &audioOutput, uint32_t frames) {
+		Sample **inputs = signalsmith::clap::bufferChannels<Sample>(audioInput);
+		Sample **outputs = signalsmith::clap::bufferChannels<Sample>(audioOutput);
+		bool dry = isDry();
 		chorus.mix = mix.value;
 		chorus.depthMs = depthMs.value;
 		chorus.detune = detune.value;
 		chorus.stereo = stereo.value;
-		chorus.process(audioInput.data32, audioOutput.data32, process->frames_count);
-
-		for (auto *param : params) {
-			param->sendEvents(eventsOut);
+		// Switching back in: the chorus catches up on the input it missed, and we stay dry until it has
+		if (dry) refilling = false;
+		bool catchingUp = !dry && wetFade <= 0 && !refillChorus(frames);
+		writeHistory(inputs, frames);
+		if (catchingUp) refillBacklog += frames;
+
+		if ((dry || catchingUp) && wetFade <= 0) {
+			// Straight copy, or nothing at all if we're processing in place
+			for (uint32_t c = 0; c < 2; ++c) {
+				if (outputs[c] != inputs[c]) std::copy_n(inputs[c], frames, outputs[c]);
+			}
+			audioOutput.constant_mask = audioInput.constant_mask;
+			return;
 		}
 
-		return CLAP_PROCESS_CONTINUE;
+		// Keep the dry signal for crossfading, since the chorus might be overwriting it
+		bool fading = dry || wetFade < 1;
+		if (fading) {
+			for (uint32_t c = 0; c < 2; ++c) std::copy_n(inputs[c], frames, dryCopy[c].data());
+		}
+		{
+			// Fine in-place (see `in_place_pair`): each input sample goes into the delay lines before that output sample is written
+			signalsmith::clap::TraceSpan span{"chorus.process"};
+			chorus.process(inputs, outputs, frames);
+		}
+		if (fading) {
+			float target = dry ? 0 : 1;
+			for (uint32_t i = 0; i < frames; ++i) {
+				wetFade = dry ? std::max(target, wetFade - fadeStep) : std::min(target, wetFade + fadeStep);
+				for (uint32_t c = 0; c < 2; ++c) {
+					double dryValue = dryCopy[c][i];
+					outputs[c][i] = Sample(dryValue + (outputs[c][i] - dryValue)*wetFade);
+				}
+			}
+		}
+		audioOutput.constant_mask = 0;
+	}
+
+	// Fully dry (bypassed, or no mix) skips the chorus, with a short crossfade either way
+	bool isDry() const {
+		return bypass.value >= 0.5 || mix.value <= 0;
+	}
+	float wetFade = 1, fadeStep = 1;
+	uint32_t maxBlock = 0;
+	std::vector<std::vector<double>> dryCopy; // for crossfades (`double`, so it's exact for either sample type)
+	std::vector<std::vector<float>> refillOutput; // discarded
+
+	/* Recent input (as long as our tail), so the chorus's delay lines can be filled back up when it's switched in again.
+
+	Copying into this is much cheaper than running the chorus while it's not being heard.  The refill is spread over a few blocks, so no single block has to run the whole tail. */
+	std::vector<std::vector<float>> history;
+	size_t historyPos = 0; // the oldest sample
+	template<class Sample>
+	void writeHistory(Sample * const *inputs, uint32_t frames) {
+		size_t length = history[0].size();
+		if (!length) return;
+		uint32_t i = uint32_t(frames > length ? frames - length : 0); // only the last `length` samples matter
+		while (i < frames) {
+			uint32_t count = uint32_t(std::min<size_t>(frames - i, length - historyPos));
+			for (uint32_t c = 0; c < 2; ++c) std::copy_n(inputs[c] + i, count, history[c].data() + historyPos);
+			i += count;
+			historyPos = (historyPos + count)%length;
+		}
+	}
+	bool refilling = false;
+	size_t refillPos = 0, refillBacklog = 0; // the history not yet fed to the chorus (which always ends at `historyPos`)
+	// Returns `true` once the chorus has caught up with the history
+	bool refillChorus(uint32_t frames) {
+		signalsmith::clap::TraceSpan span{"chorus.refill"};
+		size_t length = history[0].size();
+		if (!refilling) {
+			chorus.reset();
+			refilling = true;
+			refillPos = historyPos;
+			refillBacklog = length;
+		}
+		// Up to 4x the block size, so each block is at most 5x the usual work, and it gains 3 blocks' worth on the new input each time
+		size_t budget = std::min<size_t>(refillBacklog, size_t(frames)*4);
+		refillBacklog -= budget;
+		float *outputs[2] = {refillOutput[0].data(), refillOutput[1].data()};
+		while (budget) {
+			uint32_t count = uint32_t(std::min<size_t>({budget, length - refillPos, maxBlock}));
+			float *inputs[2] = {history[0].data() + refillPos, history[1].data() + refillPos};
+			chorus.process(inputs, outputs, count);
+			budget -= count;
+			refillPos = (refillPos + count)%length;
+		}
+		if (refillBacklog) return false;
+		refilling = false;
+		return true;
+	}
+	
+	// How long the input has been silent, up to `tailSamples`
+	uint32_t tailSamples = 0, silentSamples = 0;
+	bool sleeping = false;
+	void fallAsleep() {
+		// Clears anything still in the delay lines beyond the tail, so waking up is the same as continuing
+		chorus.reset();
+		for (auto &channel : history) std::fill(channel.begin(), channel.end(), 0);
+		sleeping = true;
+	}
+	uint32_t tailGet() {
+		return tailSamples;
 	}
 
 	bool stateDirty = false;
@@ -248,78 +338,77 @@ struct ExampleAudioPlugin {
 			stateDirty = false;
 		}
 		webviewSendIfNeeded();
+		webviewPool().trim();
+		signalsmith::clap::Trace::instance().drain();
 	}
 
 	const void * pluginGetExtension(const char *extId) {
-		if (!std::strcmp(extId, CLAP_EXT_STATE)) {
-			static const clap_plugin_state ext{
-				.save=clapPluginMethod<&Plugin::stateSave>(),
-				.load=clapPluginMethod<&Plugin::stateLoad>(),
-			};
-			return &ext;
-		} else if (!std::strcmp(extId, CLAP_EXT_AUDIO_PORTS)) {
-			static const clap_plugin_audio_ports ext{
-				.count=clapPluginMethod<&Plugin::audioPortsCount>(),
-				.get=clapPluginMethod<&Plugin::audioPortsGet>(),
-			};
-			return &ext;
-		} else if (!std::strcmp(extId, CLAP_EXT_PARAMS)) {
-			static const clap_plugin_params ext{
-				.count=clapPluginMethod<&Plugin::paramsCount>(),
-				.get_info=clapPluginMethod<&Plugin::paramsGetInfo>(),
-				.get_value=clapPluginMethod<&Plugin::paramsGetValue>(),
-				.value_to_text=clapPluginMethod<&Plugin::paramsValueToText>(),
-				.text_to_value=clapPluginMethod<&Plugin::paramsTextToValue>(),
-				.flush=clapPluginMethod<&Plugin::paramsFlush>(),
-			};
-			return &ext;
-		} else if (!std::strcmp(extId, CLAP_EXT_GUI)) {
-			static const clap_plugin_gui ext{
-				.is_api_supported=clapPluginMethod<&Plugin::guiIsApiSupported>(),
-				.get_preferred_api=clapPluginMethod<&Plugin::guiGetPreferredApi>(),
-				.create=clapPluginMethod<&Plugin::guiCreate>(),
-				.destroy=clapPluginMethod<&Plugin::guiDestroy>(),
-				.set_scale=clapPluginMethod<&Plugin::guiSetScale>(),
-				.get_size=clapPluginMethod<&Plugin::guiGetSize>(),
-				.can_resize=clapPluginMethod<&Plugin::guiCanResize>(),
-				.get_resize_hints=clapPluginMethod<&Plugin::guiGetResizeHints>(),
-				.adjust_size=clapPluginMethod<&Plugin::guiAdjustSize>(),
-				.set_size=clapPluginMethod<&Plugin::guiSetSize>(),
-				.set_parent=clapPluginMethod<&Plugin::guiSetParent>(),
-				.set_transient=clapPluginMethod<&Plugin::guiSetTransient>(),
-				.suggest_title=clapPluginMethod<&Plugin::guiSuggestTitle>(),
-				.show=clapPluginMethod<&Plugin::guiShow>(),
-				.hide=clapPluginMethod<&Plugin::guiHide>(),
-			};
-			return &ext;
-		}
-		return nullptr;
+		static const clap_plugin_state stateExt{
+			.save=clapPluginMethod<&Plugin::stateSave>(),
+			.load=clapPluginMethod<&Plugin::stateLoad>(),
+		};
+		static const clap_plugin_audio_ports audioPortsExt{
+			.count=clapPluginMethod<&Plugin::audioPortsCount>(),
+			.get=clapPluginMethod<&Plugin::audioPortsGet>(),
+		};
+		static const clap_plugin_tail tailExt{
+			.get=clapPluginMethod<&Plugin::tailGet>(),
+		};
+		static const clap_plugin_gui guiExt{
+			.is_api_supported=clapPluginMethod<&Plugin::guiIsApiSupported>(),
+			.get_preferred_api=clapPluginMethod<&Plugin::guiGetPreferredApi>(),
+			.create=clapPluginMethod<&Plugin::guiCreate>(),
+			.destroy=clapPluginMethod<&Plugin::guiDestroy>(),
+			.set_scale=clapPluginMethod<&Plugin::guiSetScale>(),
+			.get_size=clapPluginMethod<&Plugin::guiGetSize>(),
+			.can_resize=clapPluginMethod<&Plugin::guiCanResize>(),
+			.get_resize_hints=clapPluginMethod<&Plugin::guiGetResizeHints>(),
+			.adjust_size=clapPluginMethod<&Plugin::guiAdjustSize>(),
+			.set_size=clapPluginMethod<&Plugin::guiSetSize>(),
+			.set_parent=clapPluginMethod<&Plugin::guiSetParent>(),
+			.set_transient=clapPluginMethod<&Plugin::guiSetTransient>(),
+			.suggest_title=clapPluginMethod<&Plugin::guiSuggestTitle>(),
+			.show=clapPluginMethod<&Plugin::guiShow>(),
+			.hide=clapPluginMethod<&Plugin::guiHide>(),
+		};
+		static const auto extensions = signalsmith::clap::makeIdTable<const void *>({
+			{CLAP_EXT_STATE, &stateExt},
+			{CLAP_EXT_AUDIO_PORTS, &audioPortsExt},
+			{CLAP_EXT_TAIL, &tailExt},
+			{CLAP_EXT_PARAMS, signalsmith::clap::ParamRegistry::extension<&Plugin::params, &Plugin::paramsFlush>()},
+			{signalsmith::clap::CLAP_EXT_PERF_STATS, signalsmith::clap::PerfStats::extension<&Plugin::perfStats>()},
+			{CLAP_EXT_GUI, &guiExt}
+		});
+		return extensions.find(extId);
 	}
 	
 	// ---- state save/load ----
 	
+	// Change this if parameters are added/removed/reordered
+	static constexpr uint32_t stateLayoutVersion = 2;
+
 	bool stateSave(const clap_ostream_t *stream) {
-		std::vector<unsigned char> bytes;
-		signalsmith::cbor::CborWriter cbor{bytes};
-		cbor.openMap(4);
-		for (auto *param : params) {
-			cbor.addInt(param->info.id); // CBOR keys can be any type
-			cbor.addFloat(param->value);
-		}
-		return signalsmith::clap::writeAllToStream(bytes, stream);
+		return signalsmith::clap::saveParamState(params, stateLayoutVersion, stream);
 	}
 	bool stateLoad(const clap_istream_t *stream) {
+		using Result = signalsmith::clap::ParamStateResult;
 		std::vector<unsigned char> bytes;
-		if (!signalsmith::clap::readAllFromStream(bytes, stream) || bytes.empty()) return false;
-
+		auto result = signalsmith::clap::loadParamState(params, stateLayoutVersion, stream, bytes);
+		if (result == Result::error) return false;
+		if (result == Result::otherFormat && !stateLoadCbor(bytes)) return false;
+		return true;
+	}
+	// Older versions saved a CBOR map of parameter ID -> value
+	bool stateLoadCbor(const std::vector<unsigned char> &bytes) {
+		if (bytes.empty()) return false;
 		using Cbor = signalsmith::cbor::CborWalker;
 		Cbor cbor{bytes};
 		if (!cbor.isMap()) return false;
+		params.resetToDefaults(); // older states don't have every parameter
 		cbor.forEachPair([&](Cbor key, Cbor value){
-			for (auto *param : params) {
-				if (uint32_t(key) == param->info.id) {
-					param->value = double(value);
-				}
+			if (auto *param = params.find(uint32_t(key))) {
+				param->value = double(value);
+				param->sentUiState.clear();
 			}
 		});
 		return true;
@@ -335,50 +424,16 @@ struct ExampleAudioPlugin {
 		*info = {
 			.id=0xF0CACC1A,
 			.name={'m', 'a', 'i', 'n'},
-			.flags=CLAP_AUDIO_PORT_IS_MAIN + CLAP_AUDIO_PORT_REQUIRES_COMMON_SAMPLE_SIZE,
+			.flags=CLAP_AUDIO_PORT_IS_MAIN + CLAP_AUDIO_PORT_SUPPORTS_64BITS + CLAP_AUDIO_PORT_REQUIRES_COMMON_SAMPLE_SIZE,
 			.channel_count=2,
 			.port_type=CLAP_PORT_STEREO,
-			.in_place_pair=CLAP_INVALID_ID
+			.in_place_pair=0xF0CACC1A // input and output have the same ID
 		};
 		return true;
 	}
 
 	// ---- parameters ----
 	
-	uint32_t paramsCount() {
-		return uint32_t(params.size());
-	}
-	
-	bool paramsGetInfo(uint32_t index, clap_param_info *info) {
-		if (index >= params.size()) return false;
-		*info = params[index]->info;
-		return true;
-	}
-	
-	bool paramsGetValue(clap_id paramId, double *value) {
-		for (auto *param : params) {
-			if (param->info.id == paramId) {
-				*value = param->value;
-				return true;
-			}
-		}
-		return false;
-	}
-	
-	bool paramsValueToText(clap_id paramId, double value, char *text, uint32_t textCapacity) {
-		for (auto *param : params) {
-			if (param->info.id == paramId) {
-				std::snprintf(text, textCapacity, param->formatString, value);
-				return true;
-			}
-		}
-		return false;
-	}
-
-	bool paramsTextToValue(clap_id paramId, const char *text, double *value) {
-		return false; // not supported
-	}
-	
 	void paramsFlush(const clap_input_events *eventsIn, const clap_output_events *eventsOut) {
 		uint32_t eventCount = eventsIn->size(eventsIn);
 		for (uint32_t i = 0; i < eventCount; ++i) {
@@ -395,8 +450,16 @@ struct ExampleAudioPlugin {
 	
 	using WebviewGui = webview_gui::WebviewGui;
 	std::unique_ptr<WebviewGui> webview;
+	WebviewGui::Platform webviewPlatform = WebviewGui::NONE;
+	bool webviewReady = false;
 	std::atomic_flag sentWebviewState = ATOMIC_FLAG_INIT;
 
+	// Closed GUIs are kept here for a while, so re-opening is quick
+	static WebviewPool & webviewPool() {
+		static WebviewPool pool{WebviewPool::Config::fromEnvironment("SIGNALSMITH_CLAP_WEBVIEW_POOL")};
+		return pool;
+	}
+
 	static WebviewGui::Platform clapApiToPlatform(const char *api) {
 		auto platform = WebviewGui::NONE;
 		if (!std::strcmp(api, CLAP_WINDOW_API_WIN32)) platform = WebviewGui::HWND;
@@ -420,9 +483,14 @@ struct ExampleAudioPlugin {
 	bool guiCreate(const char *api, bool isFloating) {
 		if (isFloating) return false;
 		if (webview) return true; // already created before
-		webview = WebviewGui::createUnique(clapApiToPlatform(api), "/", [this](const char *path, WebviewGui::Resource &resource){
-			return webviewGetResource(path, resource);
-		});
+		webviewPlatform = clapApiToPlatform(api);
+		auto pooled = webviewPool().acquire(webviewPlatform);
+		webview = std::move(pooled.webview);
+		webviewReady = pooled.ready;
+		if (!webview) {
+			// The resource callback doesn't refer to this instance, so another instance can re-use the webview later
+			webview = WebviewGui::createUnique(webviewPlatform, "/", webviewGetResource);
+		}
 		if (webview) {
 			uint32_t w, h;
 			guiGetSize(&w, &h);
@@ -430,12 +498,14 @@ struct ExampleAudioPlugin {
 			webview->receive = [&](const unsigned char *bytes, size_t length){
 				webviewReceive(bytes, length);
 			};
+			// A re-used page won't send "ready" again, and is still showing the previous instance's values
+			if (webviewReady) webviewSendAll();
 		}
 		return bool(webview);
 	}
 	void guiDestroy() {
-		// We *could* skip this, and retain the webview indefinitely
-		// but this is more polite since it releases memory
+		// The pool might keep it (for quick re-opening) - if not, the returned webview is destroyed here
+		webviewPool().release(webviewPlatform, std::move(webview), webviewReady);
 		webview = nullptr;
 	}
 	bool guiSetScale(double scale) {
@@ -479,21 +549,21 @@ struct ExampleAudioPlugin {
 		return true;
 	}
 	
-	bool webviewGetResource(const char *path, WebviewGui::Resource &resource);
+	static bool webviewGetResource(const char *path, WebviewGui::Resource &resource);
 	bool webviewReceive(const unsigned char *bytes, size_t length) {
+		signalsmith::clap::TraceSpan span{"webview.receive"};
 		using Cbor = signalsmith::cbor::CborWalker;
 		
 		auto updateParam = [&](Param &param, Cbor cbor){
 			cbor.forEachPair([&](Cbor key, Cbor value){
 				auto keyString = key.utf8View();
 				if (keyString == "value" && value.isNumber()) {
-					param.value = value;
-					param.sentValue.clear();
+					param.uiValue(value);
 				} else if (keyString == "gesture") {
 					if (bool(value)) {
-						param.sentGestureStart.clear();
+						param.uiGestureStart();
 					} else {
-						param.sentGestureEnd.clear();
+						param.uiGestureEnd();
 					}
 				}
 			});
@@ -501,25 +571,17 @@ struct ExampleAudioPlugin {
 		
 		Cbor cbor{bytes, length};
 		if (cbor.utf8View() == "ready") {
-			for (auto *param : params) {
-				// Resend everything
-				param->sentUiState.clear();
-			}
-			sentWebviewState.clear();
-			webviewSendIfNeeded();
+			webviewReady = true;
+			webviewSendAll();
 			return true;
 		}
 		
 		cbor.forEachPair([&](Cbor key, Cbor value){
 			auto keyString = key.utf8View();
-			if (keyString == "mix") {
-				updateParam(mix, value);
-			} else if (keyString == "depth") {
-				updateParam(depthMs, value);
-			} else if (keyString == "detune") {
-				updateParam(detune, value);
-			} else if (keyString == "stereo") {
-				updateParam(stereo, value);
+			for (auto *param : params) {
+				if (keyString == param->key) {
+					updateParam(*param, value);
+				}
 			}
 		});
 
@@ -527,25 +589,29 @@ struct ExampleAudioPlugin {
 
 		return !cbor.error();
 	}
+	void webviewSendAll() {
+		for (auto *param : params) {
+			param->sentUiState.clear();
+		}
+		sentWebviewState.clear();
+		webviewSendIfNeeded();
+	}
 	void webviewSendIfNeeded() {
 		if (!webview) return;
 		if (sentWebviewState.test_and_set()) return;
+		signalsmith::clap::TraceSpan span{"webview.send"};
 
 		std::vector<unsigned char> bytes;
 		signalsmith::cbor::CborWriter cbor{bytes};
 		cbor.openMap();
 		
-		auto updateParam = [&](const char *key, Param &param){
-			if (param.sentUiState.test_and_set()) return;
-			cbor.addUtf8(key);
+		for (auto *param : params) {
+			if (param->sentUiState.test_and_set()) continue;
+			cbor.addUtf8(param->key);
 			cbor.openMap(1);
 			cbor.addUtf8("value");
-			cbor.addFloat(param.value);
-		};
-		updateParam("mix", mix);
-		updateParam("depth", depthMs);
-		updateParam("detune", detune);
-		updateParam("stereo", stereo);
+			cbor.addFloat(param->value);
+		}
 		cbor.close();
 		
 		webview->send(bytes.data(), bytes.size());
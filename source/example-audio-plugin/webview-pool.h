@@ -0,0 +1,127 @@
+#pragma once
+
+#include "webview-gui/webview-gui.h"
+#include "cbor-walker/cbor-walker.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/* Keeps closed webviews (with the page still loaded) around, so re-opening a GUI doesn't have to start from scratch.
+
+The webviews are shared between all instances of a plugin, so their resource callback mustn't refer to a particular instance.  Whoever checks one out has to replace `.receive`, and if the `Checkout` says it's ready, should send its full state straight away (since the page is already running, there won't be another "ready" message).  A page which finishes loading while it's parked has its "ready" noted, and passed on to the next owner.
+
+The limits can be set with an environment variable: `SIGNALSMITH_CLAP_WEBVIEW_POOL=<megabytes>[,<idle seconds>]`, where `0` disables the pool.
+
+All the limits are checked whenever the pool is used - there's no background timer, so an expired webview might hang around until the next time a GUI opens/closes.
+*/
+struct WebviewPool {
+	using WebviewGui = webview_gui::WebviewGui;
+	using Clock = std::chrono::steady_clock;
+
+	struct Config {
+		// Set any of these to 0 to disable the pool
+		size_t memoryBudget = 64*1024*1024;
+		size_t bytesPerWebview = 20*1024*1024; // a rough guess, including the browser process(es)
+		double idleSeconds = 60;
+
+		// Defaults, unless overridden by the environment variable
+		static Config fromEnvironment(const char *envVar) {
+			Config config;
+			const char *value = std::getenv(envVar);
+			if (value && *value) {
+				char *end;
+				config.memoryBudget = size_t(std::max(0.0, std::strtod(value, &end))*1024*1024);
+				if (*end == ',') config.idleSeconds = std::max(0.0, std::strtod(end + 1, nullptr));
+			}
+			return config;
+		}
+	};
+
+	struct Checkout {
+		std::unique_ptr<WebviewGui> webview;
+		bool ready = false; // the page has finished loading (so has already sent its own "ready" message)
+	};
+
+	WebviewPool(Config config) : config(config) {}
+	~WebviewPool() {
+		clear();
+	}
+
+	// Returns an empty `Checkout` if there's nothing suitable
+	Checkout acquire(WebviewGui::Platform platform) {
+		std::lock_guard<std::mutex> guard{mutex};
+		trimLocked();
+		for (size_t i = idle.size(); i > 0; --i) { // most recently used first
+			auto &entry = idle[i - 1];
+			if (entry.platform != platform) continue;
+			Checkout result{std::move(entry.webview), entry.ready->load()};
+			idle.erase(idle.begin() + (i - 1));
+			return result;
+		}
+		return {};
+	}
+
+	// Returns the webview if the pool didn't take it
+	std::unique_ptr<WebviewGui> release(WebviewGui::Platform platform, std::unique_ptr<WebviewGui> webview, bool ready) {
+		if (!webview || !canDetach(platform)) return webview;
+		std::lock_guard<std::mutex> guard{mutex};
+		if (maxIdle() == 0) return webview;
+
+		// Detach from the host's window (which is about to be destroyed), and ignore anything the page sends while it's parked - except for a late "ready"
+		webview->attach(nullptr);
+		auto readyFlag = std::make_shared<std::atomic<bool>>(ready);
+		webview->receive = [readyFlag](const unsigned char *bytes, size_t length){
+			if (signalsmith::cbor::CborWalker{bytes, length}.utf8View() == "ready") readyFlag->store(true);
+		};
+		idle.push_back({platform, std::move(webview), readyFlag, Clock::now()});
+		trimLocked();
+		return nullptr;
+	}
+
+	// Drop anything which has been idle too long
+	void trim() {
+		std::lock_guard<std::mutex> guard{mutex};
+		trimLocked();
+	}
+	// Should be called while the host's UI is still around, e.g. from `clap_entry.deinit()`
+	void clear() {
+		std::lock_guard<std::mutex> guard{mutex};
+		idle.clear();
+	}
+
+	// A webview has to survive its parent window being destroyed - on Windows, child `HWND`s are destroyed along with their parent
+	static bool canDetach(WebviewGui::Platform platform) {
+		return platform == WebviewGui::COCOA;
+	}
+
+private:
+	struct Entry {
+		WebviewGui::Platform platform;
+		std::unique_ptr<WebviewGui> webview;
+		std::shared_ptr<std::atomic<bool>> ready; // shared with its `.receive`
+		Clock::time_point releasedAt;
+	};
+
+	std::mutex mutex;
+	Config config;
+	std::vector<Entry> idle; // oldest first
+
+	size_t maxIdle() const {
+		if (config.bytesPerWebview == 0 || !(config.idleSeconds > 0)) return 0;
+		return config.memoryBudget/config.bytesPerWebview;
+	}
+
+	void trimLocked() {
+		auto expiry = Clock::now() - std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(config.idleSeconds));
+		size_t remove = 0;
+		while (remove < idle.size() && idle[remove].releasedAt < expiry) ++remove;
+		if (idle.size() - remove > maxIdle()) remove = idle.size() - maxIdle();
+		idle.erase(idle.begin(), idle.begin() + remove);
+	}
+};
@@ -0,0 +1,28 @@
+#include "./example-keyboard.h"
+
+#include "signalsmith-clap/cpp.h"
+
+#include <cstring>
+
+#ifdef EMBED_RESOURCES
+#	include "embedded-resources.hxx"
+#endif
+
+bool ExampleKeyboard::webviewGetResource(const char *path, char *mediaType, uint32_t mediaTypeCapacity, const clap_ostream *stream) {
+	const char *prefix = "/example-keyboard/";
+	size_t prefixLength = std::strlen(prefix);
+	if (std::strncmp(path, prefix, prefixLength)) return false;
+
+	signalsmith::clap::EmbeddedResource resource;
+	if (!clapResourcePack.find("example-keyboard", path + prefixLength, resource)) {
+#ifdef EMBED_RESOURCES
+		auto *embedded = signalsmith::clap::findResource(embedded_resources::example_keyboard, path + prefixLength);
+		if (!embedded) return false;
+		resource = *embedded;
+#else
+		return false;
+#endif
+	}
+	std::strncpy(mediaType, resource.mediaType, mediaTypeCapacity);
+	return signalsmith::clap::writeAllToStream(resource.data, resource.size, stream);
+}
@@ -1,8 +1,13 @@
 #include "clap/clap.h"
 
 #include "signalsmith-clap/cpp.h"
+#include "signalsmith-clap/id-table.h"
+#include "signalsmith-clap/instrument.h"
 #include "signalsmith-clap/note-manager.h"
 #include "signalsmith-clap/params.h"
+#include "signalsmith-clap/perf-stats.h"
+#include "signalsmith-clap/param-state.h"
+#include "signalsmith-clap/trace.h"
 
 #include "cbor-walker/cbor-walker.h"
 #include "webview-gui/clap-webview-gui.h"
@@ -55,7 +60,7 @@ struct ExampleKeyboard {
 	Param log2Rate{"log2Rate", "rate (log2)", 0x01234567, -2.0, 1.0, 4.0};
 	Param regularity{"regularity", "regularity", 0x02468ACE, 0.0, 0.5, 1.0};
 	Param velocityRand{"velocityRand", "velocity rand.", 0x12345678, 0.0, 0.5, 1.0};
-	std::array<Param *, 3> params{&log2Rate, &regularity, &velocityRand};
+	signalsmith::clap::ParamRegistry params{&log2Rate, &regularity, &velocityRand};
 	
 	ExampleKeyboard(const clap_host *host) : host(host) {
 		log2Rate.formatFn = [](double value){
@@ -72,17 +77,26 @@ struct ExampleKeyboard {
 		webview.height = 160;
 	}
 
-	// Makes a C function pointer to a C++ method
+	signalsmith::clap::PerfStats perfStats;
+#ifdef SIGNALSMITH_CLAP_INSTRUMENT
+	signalsmith::clap::Instrumentation instrumentation;
+#endif
+
+	// Makes a C function pointer to a C++ method (timing each call, checking `process()` for allocations, or capturing its events, if enabled)
 	template<auto methodPtr>
-	auto clapPluginMethod() -> decltype(signalsmith::clap::pluginMethod<methodPtr>()) {
+	static constexpr auto clapPluginMethod() -> decltype(signalsmith::clap::pluginMethod<methodPtr>()) {
+#if defined(SIGNALSMITH_CLAP_INSTRUMENT) || defined(SIGNALSMITH_CLAP_RT_GUARD) || defined(SIGNALSMITH_CLAP_CAPTURE)
+		return signalsmith::clap::instrumentedPluginMethod<methodPtr>();
+#else
 		return signalsmith::clap::pluginMethod<methodPtr>();
+#endif
 	}
 
 	const clap_plugin clapPlugin{
 		.desc=getPluginDescriptor(),
 		.plugin_data=this,
 		.init=clapPluginMethod<&Plugin::pluginInit>(),
-		.destroy=clapPluginMethod<&Plugin::pluginDestroy>(),
+		.destroy=signalsmith::clap::pluginDestroyMethod<&Plugin::pluginDestroy>(), // not timed, since it deletes the instance
 		.activate=clapPluginMethod<&Plugin::pluginActivate>(),
 		.deactivate=clapPluginMethod<&Plugin::pluginDeactivate>(),
 		.start_processing=clapPluginMethod<&Plugin::pluginStartProcessing>(),
@@ -124,21 +138,12 @@ struct ExampleKeyboard {
 		outputEventQueue.clear(); // empty any old events
 	}
 	void processEvent(const clap_event_header *event) {
+		signalsmith::clap::TraceSpan span{"processEvent"};
 		if (event->space_id != CLAP_CORE_EVENT_SPACE_ID) return;
 		if (event->type == CLAP_EVENT_PARAM_VALUE) {
 			auto &eventParam = *(const clap_event_param_value *)event;
-			if (eventParam.cookie) {
-				// if provided, it's the parameter
-				auto *param = (Param *)eventParam.cookie;
+			if (auto *param = params.find(eventParam)) {
 				param->setValueFromEvent(eventParam);
-			} else {
-				// Otherwise, match the ID
-				for (auto *param : params) {
-					if (eventParam.param_id == param->info.id) {
-						param->setValueFromEvent(eventParam);
-						break;
-					}
-				}
 			}
 
 			// Tell the host our state is dirty
@@ -162,7 +167,9 @@ struct ExampleKeyboard {
 	clap_process_status pluginProcess(const clap_process *process) {
 		noteManager.startBlock();
 		auto *eventsIn = process->in_events;
-		auto *eventsOut = process->out_events;
+		// Counts any events the host doesn't accept
+		signalsmith::clap::CountingOutputEvents countingEventsOut{process->out_events, perfStats.droppedEvents};
+		auto *eventsOut = &countingEventsOut;
 		
 		bool hasOutputEvents = outputEventMutex.try_lock(); // OK if we fail, we'll try again very soon - almost certainly faster than the UI refresh rate
 		size_t outputEventIndex = 0;
@@ -229,7 +236,15 @@ struct ExampleKeyboard {
 			sentMeters.clear();
 			host->request_callback(host);
 		}
+
+		for (auto *param : params) {
+			param->sendEvents(eventsOut);
+		}
+		perfStats.updateVoices(noteManager);
 		
+		if (signalsmith::clap::Trace::instance().needsDrain()) host->request_callback(host);
+		// No notes, meters or UI events left to send, so we can wait for the next input (or `request_process()` from the UI)
+		if (noteManager.activeNotes().empty() && meterStopCounter <= 0 && hasOutputEvents) return CLAP_PROCESS_SLEEP;
 		return CLAP_PROCESS_CONTINUE;
 	}
 	
@@ -270,73 +285,67 @@ struct ExampleKeyboard {
 			hostState->mark_dirty(host);
 		}
 		webviewSendIfNeeded();
+		signalsmith::clap::Trace::instance().drain();
 	}
 
 	const void * pluginGetExtension(const char *extId) {
-		if (!std::strcmp(extId, CLAP_EXT_STATE)) {
-			static const clap_plugin_state ext{
-				.save=clapPluginMethod<&Plugin::stateSave>(),
-				.load=clapPluginMethod<&Plugin::stateLoad>(),
-			};
-			return &ext;
-		} else if (!std::strcmp(extId, CLAP_EXT_AUDIO_PORTS)) {
-			static const clap_plugin_audio_ports ext{
-				.count=clapPluginMethod<&Plugin::audioPortsCount>(),
-				.get=clapPluginMethod<&Plugin::audioPortsGet>(),
-			};
-			return &ext;
-		} else if (!std::strcmp(extId, CLAP_EXT_NOTE_PORTS)) {
-			static const clap_plugin_note_ports ext{
-				.count=clapPluginMethod<&Plugin::notePortsCount>(),
-				.get=clapPluginMethod<&Plugin::notePortsGet>(),
-			};
-			return &ext;
-		} else if (!std::strcmp(extId, CLAP_EXT_PARAMS)) {
-			static const clap_plugin_params ext{
-				.count=clapPluginMethod<&Plugin::paramsCount>(),
-				.get_info=clapPluginMethod<&Plugin::paramsGetInfo>(),
-				.get_value=clapPluginMethod<&Plugin::paramsGetValue>(),
-				.value_to_text=clapPluginMethod<&Plugin::paramsValueToText>(),
-				.text_to_value=clapPluginMethod<&Plugin::paramsTextToValue>(),
-				.flush=clapPluginMethod<&Plugin::paramsFlush>(),
-			};
-			return &ext;
-		} else if (!std::strcmp(extId, webview_gui::CLAP_EXT_WEBVIEW)) {
-			static const webview_gui::clap_plugin_webview ext{
-				.get_uri=clapPluginMethod<&Plugin::webviewGetUri>(),
-				.get_resource=clapPluginMethod<&Plugin::webviewGetResource>(),
-				.receive=clapPluginMethod<&Plugin::webviewReceive>(),
-			};
-			return &ext;
-		}
+		static const clap_plugin_state stateExt{
+			.save=clapPluginMethod<&Plugin::stateSave>(),
+			.load=clapPluginMethod<&Plugin::stateLoad>(),
+		};
+		static const clap_plugin_audio_ports audioPortsExt{
+			.count=clapPluginMethod<&Plugin::audioPortsCount>(),
+			.get=clapPluginMethod<&Plugin::audioPortsGet>(),
+		};
+		static const clap_plugin_note_ports notePortsExt{
+			.count=clapPluginMethod<&Plugin::notePortsCount>(),
+			.get=clapPluginMethod<&Plugin::notePortsGet>(),
+		};
+		static const webview_gui::clap_plugin_webview webviewExt{
+			.get_uri=clapPluginMethod<&Plugin::webviewGetUri>(),
+			.get_resource=clapPluginMethod<&Plugin::webviewGetResource>(),
+			.receive=clapPluginMethod<&Plugin::webviewReceive>(),
+		};
+		static const auto extensions = signalsmith::clap::makeIdTable<const void *>({
+			{CLAP_EXT_STATE, &stateExt},
+			{CLAP_EXT_AUDIO_PORTS, &audioPortsExt},
+			{CLAP_EXT_NOTE_PORTS, &notePortsExt},
+			{CLAP_EXT_PARAMS, signalsmith::clap::ParamRegistry::extension<&Plugin::params, &Plugin::paramsFlush>()},
+			{signalsmith::clap::CLAP_EXT_PERF_STATS, signalsmith::clap::PerfStats::extension<&Plugin::perfStats>()},
+			{webview_gui::CLAP_EXT_WEBVIEW, &webviewExt}
+		});
+		if (auto *ext = extensions.find(extId)) return ext;
 		return webview.getExtension(extId);
 	}
 	
 	// ---- state save/load ----
 	
+	// Change this if parameters are added/removed/reordered
+	static constexpr uint32_t stateLayoutVersion = 1;
+
 	bool stateSave(const clap_ostream_t *stream) {
-		std::vector<unsigned char> bytes;
-		signalsmith::cbor::CborWriter cbor{bytes};
-		cbor.openMap(4);
-		for (auto *param : params) {
-			cbor.addInt(param->info.id); // CBOR keys can be any type
-			cbor.addFloat(param->value);
-		}
 		stateIsClean.test_and_set();
-		return signalsmith::clap::writeAllToStream(bytes, stream);
+		return signalsmith::clap::saveParamState(params, stateLayoutVersion, stream);
 	}
 	bool stateLoad(const clap_istream_t *stream) {
+		using Result = signalsmith::clap::ParamStateResult;
 		std::vector<unsigned char> bytes;
-		if (!signalsmith::clap::readAllFromStream(bytes, stream) || bytes.empty()) return false;
-
+		auto result = signalsmith::clap::loadParamState(params, stateLayoutVersion, stream, bytes);
+		if (result == Result::error) return false;
+		if (result == Result::otherFormat && !stateLoadCbor(bytes)) return false;
+		return true;
+	}
+	// Older versions saved a CBOR map of parameter ID -> value
+	bool stateLoadCbor(const std::vector<unsigned char> &bytes) {
+		if (bytes.empty()) return false;
 		using Cbor = signalsmith::cbor::CborWalker;
 		Cbor cbor{bytes};
 		if (!cbor.isMap()) return false;
+		params.resetToDefaults(); // older states don't have every parameter
 		cbor.forEachPair([&](Cbor key, Cbor value){
-			for (auto *param : params) {
-				if (uint32_t(key) == param->info.id) {
-					param->value = double(value);
-				}
+			if (auto *param = params.find(uint32_t(key))) {
+				param->value = double(value);
+				param->sentUiState.clear();
 			}
 		});
 		return true;
@@ -370,45 +379,6 @@ struct ExampleKeyboard {
 
 	// ---- parameters ----
 	
-	uint32_t paramsCount() {
-		return uint32_t(params.size());
-	}
-	
-	bool paramsGetInfo(uint32_t index, clap_param_info *info) {
-		if (index >= params.size()) return false;
-		*info = params[index]->info;
-		return true;
-	}
-	
-	bool paramsGetValue(clap_id paramId, double *value) {
-		for (auto *param : params) {
-			if (param->info.id == paramId) {
-				*value = param->value;
-				return true;
-			}
-		}
-		return false;
-	}
-	
-	bool paramsValueToText(clap_id paramId, double value, char *text, uint32_t textCapacity) {
-		for (auto *param : params) {
-			if (param->info.id == paramId) {
-				if (param->formatFn) {
-					auto str = param->formatFn(value);
-					std::strncpy(text, str.c_str(), textCapacity);
-				} else {
-					std::snprintf(text, textCapacity, param->formatString, value);
-				}
-				return true;
-			}
-		}
-		return false;
-	}
-
-	bool paramsTextToValue(clap_id paramId, const char *text, double *value) {
-		return false; // not supported
-	}
-	
 	void paramsFlush(const clap_input_events *eventsIn, const clap_output_events *eventsOut) {
 		uint32_t eventCount = eventsIn->size(eventsIn);
 		for (uint32_t i = 0; i < eventCount; ++i) {
@@ -430,22 +400,15 @@ struct ExampleKeyboard {
 	std::atomic_flag sentWebviewState = ATOMIC_FLAG_INIT;
 	
 	int32_t webviewGetUri(char *uri, uint32_t uri_capacity) {
-		std::string fileUrl = "file://" + clapBundleResourceDir + "/example-keyboard/keyboard.html";
-#ifdef WIN32
-		for (auto &c : fileUrl) {
-			if (c == '\\') c = '/';
-		}
-#endif
-		if (uri) std::strncpy(uri, fileUrl.c_str(), uri_capacity);
-		return fileUrl.size();
+		const char *relativeUrl = "/example-keyboard/";
+		if (uri) std::strncpy(uri, relativeUrl, uri_capacity);
+		return std::strlen(relativeUrl);
 	}
 	
-	bool webviewGetResource(const char *path, char *mediaType, uint32_t mediaTypeCapacity, const clap_ostream *stream) {
-		// Since we're using an absolute (`file:`) URL, we don't need this
-		return false;
-	}
+	bool webviewGetResource(const char *path, char *mediaType, uint32_t mediaTypeCapacity, const clap_ostream *stream);
 
 	bool webviewReceive(const void *bytes, uint32_t length) {
+		signalsmith::clap::TraceSpan span{"webview.receive"};
 		using Cbor = signalsmith::cbor::CborWalker;
 		Cbor cbor{(const unsigned char *)bytes, length};
 		
@@ -455,6 +418,7 @@ struct ExampleKeyboard {
 			meterInterval = 1/fps;
 			meterStopCounter = 0.5; // send 500ms of meters before requiring another FPS update
 			if (meterIntervalCounter < -meterInterval) meterIntervalCounter = 0;
+			host->request_process(host); // in case we're asleep
 		} else if (cbor.isMap()) {
 			clap_event_note event{
 				.header={
@@ -482,13 +446,17 @@ struct ExampleKeyboard {
 				}
 			});
 			
-			std::lock_guard<std::mutex> guard{outputEventMutex}; // OK to block (if the audio thread is processing right now), this UI thread is not realtime
-			outputEventQueue.push_back(event);
+			{
+				std::lock_guard<std::mutex> guard{outputEventMutex}; // OK to block (if the audio thread is processing right now), this UI thread is not realtime
+				outputEventQueue.push_back(event);
+			}
+			host->request_process(host);
 		}
 		return !cbor.error();
 	}
 	void webviewSendIfNeeded() {
 		if (!sentMeters.test_and_set()) {
+			signalsmith::clap::TraceSpan span{"webview.send"};
 			std::vector<unsigned char> bytes;
 			writeMeters(bytes);
 			hasMeters.clear(); // We're done with the metering data - `.process()` can fill it up again
@@ -496,6 +464,7 @@ struct ExampleKeyboard {
 		}
 
 		if (!sentWebviewState.test_and_set()) {
+			signalsmith::clap::TraceSpan span{"webview.send"};
 			std::vector<unsigned char> bytes;
 			signalsmith::cbor::CborWriter cbor{bytes};
 			cbor.openMap();
@@ -1,6 +1,6 @@
 #ifndef LOG_EXPR
-#	include <iostream>
-#	define LOG_EXPR(expr) std::cout << #expr " = " << (expr) << std::endl;
+#	include "signalsmith-clap/log.h"
+#	define LOG_EXPR(expr) SIGNALSMITH_CLAP_LOG_EXPR(expr)
 #endif
 
 #include "./example-note-plugin.h"
@@ -9,32 +9,26 @@
 
 #include <cstring>
 
-namespace example_note_plugin_resources {
-#include "./resources/index.html.hxx"
-#include "./resources/cbor.min.js.hxx"
-};
+#ifdef EMBED_RESOURCES
+#	include "embedded-resources.hxx"
+#endif
 
 bool ExampleNotePlugin::webviewGetResource(const char *path, char *mediaType, uint32_t mediaTypeCapacity, const clap_ostream *stream) {
-	using namespace example_note_plugin_resources;
-
-	const char *type = nullptr;
-	std::vector<unsigned char> bytes;
+	const char *prefix = "/example-note-plugin/";
+	size_t prefixLength = std::strlen(prefix);
+	if (std::strncmp(path, prefix, prefixLength)) return false;
 
-	if (!std::strcmp(path, "/example-note-plugin/")) {
-		type = "text/html";
-		bytes.assign(
-			(const unsigned char *)index_html,
-			(const unsigned char *)index_html + sizeof(index_html)
-		);
-	} else if (!std::strcmp(path, "/example-note-plugin/cbor.min.js")) {
-		type = "application/javascript";
-		bytes.assign(
-			(const unsigned char *)cbor_min_js,
-			(const unsigned char *)cbor_min_js + sizeof(cbor_min_js)
-		);
+	signalsmith::clap::EmbeddedResource resource;
+	if (!clapResourcePack.find("example-note-plugin", path + prefixLength, resource)) {
+#ifdef EMBED_RESOURCES
+		auto *embedded = signalsmith::clap::findResource(embedded_resources::example_note_plugin, path + prefixLength);
+		if (!embedded) return false;
+		resource = *embedded;
+#else
+		return false;
+#endif
 	}
-	
-	if (!type) return false;
-	std::strncpy(mediaType, type, mediaTypeCapacity);
-	return signalsmith::clap::writeAllToStream(bytes, stream);
+	std::strncpy(mediaType, resource.mediaType, mediaTypeCapacity);
+	// Straight from the mapped/embedded data, no copy
+	return signalsmith::clap::writeAllToStream(resource.data, resource.size, stream);
 }
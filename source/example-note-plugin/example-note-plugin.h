@@ -1,8 +1,13 @@
 #include "clap/clap.h"
 
 #include "signalsmith-clap/cpp.h"
+#include "signalsmith-clap/id-table.h"
+#include "signalsmith-clap/instrument.h"
 #include "signalsmith-clap/note-manager.h"
 #include "signalsmith-clap/params.h"
+#include "signalsmith-clap/perf-stats.h"
+#include "signalsmith-clap/param-state.h"
+#include "signalsmith-clap/trace.h"
 
 #include "cbor-walker/cbor-walker.h"
 #include "webview-gui/clap-webview-gui.h"
@@ -61,7 +66,7 @@ struct ExampleNotePlugin {
 	Param log2Rate{"log2Rate", "rate (log2)", 0x01234567, -2.0, 1.0, 4.0};
 	Param regularity{"regularity", "regularity", 0x02468ACE, 0.0, 0.65, 1.0};
 	Param velocityRand{"velocityRand", "velocity rand.", 0x12345678, 0.0, 0.5, 1.0};
-	std::array<Param *, 3> params{&log2Rate, &regularity, &velocityRand};
+	signalsmith::clap::ParamRegistry params{&log2Rate, &regularity, &velocityRand};
 
 	void resendAllUiState() {
 		// Send everything
@@ -80,17 +85,26 @@ struct ExampleNotePlugin {
 		};
 	}
 
-	// Makes a C function pointer to a C++ method
+	signalsmith::clap::PerfStats perfStats;
+#ifdef SIGNALSMITH_CLAP_INSTRUMENT
+	signalsmith::clap::Instrumentation instrumentation;
+#endif
+
+	// Makes a C function pointer to a C++ method (timing each call, checking `process()` for allocations, or capturing its events, if enabled)
 	template<auto methodPtr>
-	auto clapPluginMethod() -> decltype(signalsmith::clap::pluginMethod<methodPtr>()) {
+	static constexpr auto clapPluginMethod() -> decltype(signalsmith::clap::pluginMethod<methodPtr>()) {
+#if defined(SIGNALSMITH_CLAP_INSTRUMENT) || defined(SIGNALSMITH_CLAP_RT_GUARD) || defined(SIGNALSMITH_CLAP_CAPTURE)
+		return signalsmith::clap::instrumentedPluginMethod<methodPtr>();
+#else
 		return signalsmith::clap::pluginMethod<methodPtr>();
+#endif
 	}
 
 	const clap_plugin clapPlugin{
 		.desc=getPluginDescriptor(),
 		.plugin_data=this,
 		.init=clapPluginMethod<&Plugin::pluginInit>(),
-		.destroy=clapPluginMethod<&Plugin::pluginDestroy>(),
+		.destroy=signalsmith::clap::pluginDestroyMethod<&Plugin::pluginDestroy>(), // not timed, since it deletes the instance
 		.activate=clapPluginMethod<&Plugin::pluginActivate>(),
 		.deactivate=clapPluginMethod<&Plugin::pluginDeactivate>(),
 		.start_processing=clapPluginMethod<&Plugin::pluginStartProcessing>(),
@@ -128,21 +142,12 @@ struct ExampleNotePlugin {
 		noteManager.reset();
 	}
 	void processEvent(const clap_event_header *event) {
+		signalsmith::clap::TraceSpan span{"processEvent"};
 		if (event->space_id != CLAP_CORE_EVENT_SPACE_ID) return;
 		if (event->type == CLAP_EVENT_PARAM_VALUE) {
 			auto &eventParam = *(const clap_event_param_value *)event;
-			if (eventParam.cookie) {
-				// if provided, it's the parameter
-				auto *param = (Param *)eventParam.cookie;
+			if (auto *param = params.find(eventParam)) {
 				param->setValueFromEvent(eventParam);
-			} else {
-				// Otherwise, match the ID
-				for (auto *param : params) {
-					if (eventParam.param_id == param->info.id) {
-						param->setValueFromEvent(eventParam);
-						break;
-					}
-				}
 			}
 
 			// Tell the host our state is dirty
@@ -156,7 +161,9 @@ struct ExampleNotePlugin {
 	
 	std::uniform_real_distribution<double> unitReal{0, 1};
 	clap_process_status pluginProcess(const clap_process *process) {
-		auto *eventsOut = process->out_events;
+		// Counts any events the host doesn't accept
+		signalsmith::clap::CountingOutputEvents countingEventsOut{process->out_events, perfStats.droppedEvents};
+		auto *eventsOut = &countingEventsOut;
 
 		noteManager.startBlock();
 		auto processNoteTasks = [&](auto &tasks) {
@@ -250,7 +257,15 @@ struct ExampleNotePlugin {
 			}
 		}
 
-		return CLAP_PROCESS_CONTINUE;
+		// Any UI interactions since the last block
+		for (auto *param : params) {
+			param->sendEvents(eventsOut);
+		}
+		perfStats.updateVoices(noteManager);
+
+		if (signalsmith::clap::Trace::instance().needsDrain()) host->request_callback(host);
+		// Nothing to retrigger until another note arrives
+		return noteManager.activeNotes().empty() ? CLAP_PROCESS_SLEEP : CLAP_PROCESS_CONTINUE;
 	}
 	
 	template<class ClapEvent>
@@ -277,77 +292,71 @@ struct ExampleNotePlugin {
 			hostState->mark_dirty(host);
 		}
 		webviewSendIfNeeded();
+		signalsmith::clap::Trace::instance().drain();
 	}
 
 	const void * pluginGetExtension(const char *extId) {
-		if (!std::strcmp(extId, CLAP_EXT_STATE)) {
-			static const clap_plugin_state ext{
-				.save=clapPluginMethod<&Plugin::stateSave>(),
-				.load=clapPluginMethod<&Plugin::stateLoad>(),
-			};
-			return &ext;
-		} else if (!std::strcmp(extId, CLAP_EXT_AUDIO_PORTS)) {
-			static const clap_plugin_audio_ports ext{
-				.count=clapPluginMethod<&Plugin::audioPortsCount>(),
-				.get=clapPluginMethod<&Plugin::audioPortsGet>(),
-			};
-			return &ext;
-		} else if (!std::strcmp(extId, CLAP_EXT_NOTE_PORTS)) {
-			static const clap_plugin_note_ports ext{
-				.count=clapPluginMethod<&Plugin::notePortsCount>(),
-				.get=clapPluginMethod<&Plugin::notePortsGet>(),
-			};
-			return &ext;
-		} else if (!std::strcmp(extId, CLAP_EXT_PARAMS)) {
-			static const clap_plugin_params ext{
-				.count=clapPluginMethod<&Plugin::paramsCount>(),
-				.get_info=clapPluginMethod<&Plugin::paramsGetInfo>(),
-				.get_value=clapPluginMethod<&Plugin::paramsGetValue>(),
-				.value_to_text=clapPluginMethod<&Plugin::paramsValueToText>(),
-				.text_to_value=clapPluginMethod<&Plugin::paramsTextToValue>(),
-				.flush=clapPluginMethod<&Plugin::paramsFlush>(),
-			};
-			return &ext;
-		} else if (!std::strcmp(extId, webview_gui::CLAP_EXT_WEBVIEW)) {
-			static const webview_gui::clap_plugin_webview ext{
-				.get_uri=clapPluginMethod<&Plugin::webviewGetUri>(),
-				.get_resource=clapPluginMethod<&Plugin::webviewGetResource>(),
-				.receive=clapPluginMethod<&Plugin::webviewReceive>(),
-			};
-			return &ext;
-		}
+		static const clap_plugin_state stateExt{
+			.save=clapPluginMethod<&Plugin::stateSave>(),
+			.load=clapPluginMethod<&Plugin::stateLoad>(),
+		};
+		static const clap_plugin_audio_ports audioPortsExt{
+			.count=clapPluginMethod<&Plugin::audioPortsCount>(),
+			.get=clapPluginMethod<&Plugin::audioPortsGet>(),
+		};
+		static const clap_plugin_note_ports notePortsExt{
+			.count=clapPluginMethod<&Plugin::notePortsCount>(),
+			.get=clapPluginMethod<&Plugin::notePortsGet>(),
+		};
+		static const webview_gui::clap_plugin_webview webviewExt{
+			.get_uri=clapPluginMethod<&Plugin::webviewGetUri>(),
+			.get_resource=clapPluginMethod<&Plugin::webviewGetResource>(),
+			.receive=clapPluginMethod<&Plugin::webviewReceive>(),
+		};
+		static const auto extensions = signalsmith::clap::makeIdTable<const void *>({
+			{CLAP_EXT_STATE, &stateExt},
+			{CLAP_EXT_AUDIO_PORTS, &audioPortsExt},
+			{CLAP_EXT_NOTE_PORTS, &notePortsExt},
+			{CLAP_EXT_PARAMS, signalsmith::clap::ParamRegistry::extension<&Plugin::params, &Plugin::paramsFlush>()},
+			{signalsmith::clap::CLAP_EXT_PERF_STATS, signalsmith::clap::PerfStats::extension<&Plugin::perfStats>()},
+			{webview_gui::CLAP_EXT_WEBVIEW, &webviewExt}
+		});
+		if (auto *ext = extensions.find(extId)) return ext;
 		return webview.getExtension(extId);
 	}
 	
 	// ---- state save/load ----
 	
+	// Change this if parameters are added/removed/reordered
+	static constexpr uint32_t stateLayoutVersion = 1;
+
 	bool stateSave(const clap_ostream_t *stream) {
-		std::vector<unsigned char> bytes;
-		signalsmith::cbor::CborWriter cbor{bytes};
-		cbor.openMap(4);
-		for (auto *param : params) {
-			cbor.addInt(param->info.id); // CBOR keys can be any type
-			cbor.addFloat(param->value);
-		}
 		stateIsClean.test_and_set();
-		return signalsmith::clap::writeAllToStream(bytes, stream);
+		return signalsmith::clap::saveParamState(params, stateLayoutVersion, stream);
 	}
 	bool stateLoad(const clap_istream_t *stream) {
+		using Result = signalsmith::clap::ParamStateResult;
 		std::vector<unsigned char> bytes;
-		if (!signalsmith::clap::readAllFromStream(bytes, stream) || bytes.empty()) return false;
-
+		auto result = signalsmith::clap::loadParamState(params, stateLayoutVersion, stream, bytes);
+		if (result == Result::error) return false;
+		if (result == Result::otherFormat && !stateLoadCbor(bytes)) return false;
+		resendAllUiState();
+		host->request_callback(host);
+		return true;
+	}
+	// Older versions saved a CBOR map of parameter ID -> value
+	bool stateLoadCbor(const std::vector<unsigned char> &bytes) {
+		if (bytes.empty()) return false;
 		using Cbor = signalsmith::cbor::CborWalker;
 		Cbor cbor{bytes};
 		if (!cbor.isMap()) return false;
+		params.resetToDefaults(); // older states don't have every parameter
 		cbor.forEachPair([&](Cbor key, Cbor value){
-			for (auto *param : params) {
-				if (uint32_t(key) == param->info.id) {
-					param->value = double(value);
-				}
+			if (auto *param = params.find(uint32_t(key))) {
+				param->value = double(value);
+				param->sentUiState.clear();
 			}
 		});
-		resendAllUiState();
-		host->request_callback(host);
 		return true;
 	}
 
@@ -379,45 +388,6 @@ struct ExampleNotePlugin {
 
 	// ---- parameters ----
 	
-	uint32_t paramsCount() {
-		return uint32_t(params.size());
-	}
-	
-	bool paramsGetInfo(uint32_t index, clap_param_info *info) {
-		if (index >= params.size()) return false;
-		*info = params[index]->info;
-		return true;
-	}
-	
-	bool paramsGetValue(clap_id paramId, double *value) {
-		for (auto *param : params) {
-			if (param->info.id == paramId) {
-				*value = param->value;
-				return true;
-			}
-		}
-		return false;
-	}
-	
-	bool paramsValueToText(clap_id paramId, double value, char *text, uint32_t textCapacity) {
-		for (auto *param : params) {
-			if (param->info.id == paramId) {
-				if (param->formatFn) {
-					auto str = param->formatFn(value);
-					std::strncpy(text, str.c_str(), textCapacity);
-				} else {
-					std::snprintf(text, textCapacity, param->formatString, value);
-				}
-				return true;
-			}
-		}
-		return false;
-	}
-
-	bool paramsTextToValue(clap_id paramId, const char *text, double *value) {
-		return false; // not supported
-	}
-	
 	void paramsFlush(const clap_input_events *eventsIn, const clap_output_events *eventsOut) {
 		uint32_t eventCount = eventsIn->size(eventsIn);
 		for (uint32_t i = 0; i < eventCount; ++i) {
@@ -447,19 +417,19 @@ struct ExampleNotePlugin {
 	bool webviewGetResource(const char *path, char *mediaType, uint32_t mediaTypeCapacity, const clap_ostream *stream);
 
 	bool webviewReceive(const void *bytes, uint32_t length) {
+		signalsmith::clap::TraceSpan span{"webview.receive"};
 		using Cbor = signalsmith::cbor::CborWalker;
 		
 		auto updateParam = [&](Param &param, Cbor cbor){
 			cbor.forEachPair([&](Cbor key, Cbor value){
 				auto keyString = key.utf8View();
 				if (keyString == "value" && value.isNumber()) {
-					param.value = value;
-					param.sentValue.clear();
+					param.uiValue(value);
 				} else if (keyString == "gesture") {
 					if (bool(value)) {
-						param.sentGestureStart.clear();
+						param.uiGestureStart();
 					} else {
-						param.sentGestureEnd.clear();
+						param.uiGestureEnd();
 					}
 				}
 			});
@@ -489,6 +459,7 @@ struct ExampleNotePlugin {
 	}
 	void webviewSendIfNeeded() {
 		if (sentWebviewState.test_and_set()) return;
+		signalsmith::clap::TraceSpan span{"webview.send"};
 
 		std::vector<unsigned char> bytes;
 		signalsmith::cbor::CborWriter cbor{bytes};
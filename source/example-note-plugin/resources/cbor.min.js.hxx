@@ -1,438 +0,0 @@
-const unsigned char cbor_min_js[] = {
-// 0
-0x6c,0x65,0x74,0x20,0x43,0x42,0x4f,0x52,0x3d,0x7b,0x65,0x6e,0x63,0x6f,0x64,0x65,
-0x28,0x65,0x2c,0x74,0x29,0x7b,0x6c,0x65,0x74,0x20,0x69,0x3d,0x30,0x2c,0x6f,0x3d,
-0x74,0x7c,0x7c,0x6e,0x65,0x77,0x20,0x41,0x72,0x72,0x61,0x79,0x42,0x75,0x66,0x66,
-0x65,0x72,0x28,0x36,0x34,0x2c,0x7b,0x6d,0x61,0x78,0x42,0x79,0x74,0x65,0x4c,0x65,
-0x6e,0x67,0x74,0x68,0x3a,0x36,0x34,0x7d,0x29,0x2c,0x66,0x3d,0x28,0x6f,0x2e,0x72,
-0x65,0x73,0x69,0x7a,0x61,0x62,0x6c,0x65,0x26,0x26,0x6f,0x2e,0x72,0x65,0x73,0x69,
-0x7a,0x65,0x28,0x6f,0x2e,0x6d,0x61,0x78,0x42,0x79,0x74,0x65,0x4c,0x65,0x6e,0x67,
-0x74,0x68,0x29,0x2c,0x6e,0x65,0x77,0x20,0x44,0x61,0x74,0x61,0x56,0x69,0x65,0x77,
-0x28,0x6f,0x29,0x29,0x2c,0x73,0x3d,0x5b,0x6f,0x5d,0x2c,0x6c,0x3d,0x43,0x42,0x4f,
-0x52,0x2e,0x65,0x6e,0x63,0x6f,0x64,0x65,0x54,0x61,0x67,0x3b,0x66,0x75,0x6e,0x63,
-0x74,0x69,0x6f,0x6e,0x20,0x79,0x28,0x65,0x2c,0x74,0x2c,0x72,0x29,0x7b,0x76,0x61,
-0x72,0x20,0x6e,0x3d,0x31,0x2b,0x72,0x3b,0x69,0x66,0x28,0x69,0x2b,0x6e,0x3e,0x6f,
-0x2e,0x62,0x79,0x74,0x65,0x4c,0x65,0x6e,0x67,0x74,0x68,0x29,0x7b,0x6c,0x65,0x74,
-0x20,0x65,0x3d,0x31,0x3b,0x66,0x6f,0x72,0x28,0x3b,0x65,0x3c,0x3d,0x6f,0x2e,0x62,
-0x79,0x74,0x65,0x4c,0x65,0x6e,0x67,0x74,0x68,0x7c,0x7c,0x65,0x3c,0x3d,0x72,0x3b,
-0x29,0x65,0x2a,0x3d,0x32,0x3b,0x6f,0x2e,0x72,0x65,0x73,0x69,0x7a,0x61,0x62,0x6c,
-0x65,0x3f,0x6f,0x2e,0x72,0x65,0x73,0x69,0x7a,0x65,0x28,0x69,0x29,0x3a,0x69,0x21,
-0x3d,0x6f,0x2e,0x62,0x79,0x74,0x65,0x4c,0x65,0x6e,0x67,0x74,0x68,0x26,0x26,0x73,
-0x2e,0x70,0x75,0x73,0x68,0x28,0x73,0x2e,0x70,0x6f,0x70,0x28,0x29,0x2e,0x73,0x6c,
-0x69,0x63,0x65,0x28,0x30,0x2c,0x69,0x29,0x29,0x2c,0x69,0x3d,0x30,0x2c,0x6f,0x3d,
-0x6e,0x65,0x77,0x20,0x41,0x72,0x72,0x61,0x79,0x42,0x75,0x66,0x66,0x65,0x72,0x28,
-0x65,0x2c,0x7b,0x6d,0x61,0x78,0x42,0x79,0x74,0x65,0x4c,0x65,0x6e,0x67,0x74,0x68,
-0x3a,0x65,0x7d,0x29,0x2c,0x73,0x2e,0x70,0x75,0x73,0x68,0x28,0x6f,0x29,0x2c,0x66,
-0x3d,0x6e,0x65,0x77,0x20,0x44,0x61,0x74,0x61,0x56,0x69,0x65,0x77,0x28,0x6f,0x29,
-0x7d,0x76,0x61,0x72,0x20,0x61,0x3d,0x69,0x3b,0x72,0x65,0x74,0x75,0x72,0x6e,0x20,
-0x69,0x2b,0x3d,0x6e,0x2c,0x66,0x2e,0x73,0x65,0x74,0x55,0x69,0x6e,0x74,0x38,0x28,
-0x61,0x2c,0x65,0x3c,0x3c,0x35,0x7c,0x74,0x29,0x2c,0x61,0x2b,0x31,0x7d,0x66,0x75,
-0x6e,0x63,0x74,0x69,0x6f,0x6e,0x20,0x75,0x28,0x65,0x2c,0x74,0x2c,0x72,0x29,0x7b,
-0x76,0x61,0x72,0x20,0x6e,0x3b,0x72,0x65,0x74,0x75,0x72,0x6e,0x20,0x74,0x3c,0x32,
-0x34,0x3f,0x79,0x28,0x65,0x2c,0x74,0x2c,0x72,0x29,0x3a,0x74,0x3c,0x32,0x35,0x36,
-0x3f,0x28,0x6e,0x3d,0x79,0x28,0x65,0x2c,0x32,0x34,0x2c,0x72,0x2b,0x31,0x29,0x2c,
-0x66,0x2e,0x73,0x65,0x74,0x55,0x69,0x6e,0x74,0x38,0x28,0x6e,0x2c,0x74,0x29,0x2c,
-0x6e,0x2b,0x31,0x29,0x3a,0x74,0x3c,0x36,0x35,0x35,0x33,0x36,0x3f,0x28,0x6e,0x3d,
-0x79,0x28,0x65,0x2c,0x32,0x35,0x2c,0x72,0x2b,0x32,0x29,0x2c,0x66,0x2e,0x73,0x65,
-0x74,0x55,0x69,0x6e,0x74,0x31,0x36,0x28,0x6e,0x2c,0x74,0x29,0x2c,0x6e,0x2b,0x32,
-0x29,0x3a,0x28,0x6e,0x3d,0x79,0x28,0x65,0x2c,0x32,0x36,0x2c,0x72,0x2b,0x34,0x29,
-0x2c,0x66,0x2e,0x73,0x65,0x74,0x55,0x69,0x6e,0x74,0x33,0x32,0x28,0x6e,0x2c,0x74,
-0x29,0x2c,0x6e,0x2b,0x34,0x29,0x7d,0x69,0x66,0x28,0x21,0x66,0x75,0x6e,0x63,0x74,
-0x69,0x6f,0x6e,0x20,0x74,0x28,0x72,0x29,0x7b,0x69,0x66,0x28,0x22,0x6e,0x75,0x6d,
-0x62,0x65,0x72,0x22,0x3d,0x3d,0x74,0x79,0x70,0x65,0x6f,0x66,0x20,0x72,0x29,0x4e,
-0x75,0x6d,0x62,0x65,0x72,0x2e,0x69,0x73,0x49,0x6e,0x74,0x65,0x67,0x65,0x72,0x28,
-0x72,0x29,0x26,0x26,0x72,0x3c,0x3d,0x4e,0x75,0x6d,0x62,0x65,0x72,0x2e,0x4d,0x41,
-0x58,0x5f,0x53,0x41,0x46,0x45,0x5f,0x49,0x4e,0x54,0x45,0x47,0x45,0x52,0x26,0x26,
-0x72,0x3e,0x3d,0x4e,0x75,0x6d,0x62,0x65,0x72,0x2e,0x4d,0x49,0x4e,0x5f,0x53,0x41,
-0x46,0x45,0x5f,0x49,0x4e,0x54,0x45,0x47,0x45,0x52,0x3f,0x30,0x3c,0x3d,0x72,0x3f,
-0x72,0x3c,0x34,0x32,0x39,0x34,0x39,0x36,0x37,0x32,0x39,0x36,0x3f,0x75,0x28,0x30,
-0x2c,0x72,0x2c,0x30,0x29,0x3a,0x72,0x3c,0x30,0x78,0x31,0x30,0x30,0x30,0x30,0x30,
-0x30,0x30,0x30,0x30,0x30,0x30,0x30,0x30,0x30,0x30,0x30,0x3f,0x28,0x65,0x3d,0x79,
-0x28,0x30,0x2c,0x32,0x37,0x2c,0x38,0x29,0x2c,0x66,0x2e,0x73,0x65,0x74,0x42,0x69,
-0x67,0x55,0x69,0x6e,0x74,0x36,0x34,0x28,0x65,0x2c,0x42,0x69,0x67,0x49,0x6e,0x74,
-0x28,0x72,0x29,0x29,0x29,0x3a,0x28,0x65,0x3d,0x79,0x28,0x37,0x2c,0x32,0x37,0x2c,
-0x38,0x29,0x2c,0x66,0x2e,0x73,0x65,0x74,0x46,0x6c,0x6f,0x61,0x74,0x36,0x34,0x28,
-0x65,0x2c,0x72,0x29,0x29,0x3a,0x2d,0x34,0x32,0x39,0x34,0x39,0x36,0x37,0x32,0x39,
-0x36,0x3c,0x3d,0x72,0x3f,0x75,0x28,0x31,0x2c,0x2d,0x31,0x2d,0x72,0x2c,0x30,0x29,
-0x3a,0x2d,0x31,0x38,0x34,0x34,0x36,0x37,0x34,0x34,0x30,0x37,0x33,0x37,0x30,0x39,
-0x35,0x35,0x31,0x36,0x31,0x36,0x6e,0x3c,0x3d,0x72,0x3f,0x28,0x65,0x3d,0x79,0x28,
-0x31,0x2c,0x32,0x37,0x2c,0x38,0x29,0x2c,0x66,0x2e,0x73,0x65,0x74,0x42,0x69,0x67,
-0x55,0x69,0x6e,0x74,0x36,0x34,0x28,0x65,0x2c,0x42,0x69,0x67,0x49,0x6e,0x74,0x28,
-0x2d,0x31,0x2d,0x72,0x29,0x29,0x29,0x3a,0x28,0x65,0x3d,0x79,0x28,0x37,0x2c,0x32,
-0x36,0x2c,0x38,0x29,0x2c,0x66,0x2e,0x73,0x65,0x74,0x46,0x6c,0x6f,0x61,0x74,0x36,
-0x34,0x28,0x65,0x2c,0x72,0x29,0x29,0x3a,0x28,0x65,0x3d,0x79,0x28,0x37,0x2c,0x32,
-0x37,0x2c,0x38,0x29,0x2c,0x66,0x2e,0x73,0x65,0x74,0x46,0x6c,0x6f,0x61,0x74,0x36,
-0x34,0x28,0x65,0x2c,0x72,0x29,0x29,0x3b,0x65,0x6c,0x73,0x65,0x20,0x69,0x66,0x28,
-0x22,0x62,0x69,0x67,0x69,0x6e,0x74,0x22,0x3d,0x3d,0x74,0x79,0x70,0x65,0x6f,0x66,
-// 1024
-0x20,0x72,0x29,0x69,0x66,0x28,0x30,0x3c,0x3d,0x72,0x29,0x69,0x66,0x28,0x72,0x3c,
-0x31,0x38,0x34,0x34,0x36,0x37,0x34,0x34,0x30,0x37,0x33,0x37,0x30,0x39,0x35,0x35,
-0x31,0x36,0x31,0x36,0x6e,0x29,0x7b,0x76,0x61,0x72,0x20,0x65,0x3d,0x79,0x28,0x30,
-0x2c,0x32,0x37,0x2c,0x38,0x29,0x3b,0x66,0x2e,0x73,0x65,0x74,0x42,0x69,0x67,0x55,
-0x69,0x6e,0x74,0x36,0x34,0x28,0x65,0x2c,0x72,0x29,0x7d,0x65,0x6c,0x73,0x65,0x7b,
-0x79,0x28,0x36,0x2c,0x32,0x2c,0x30,0x29,0x3b,0x66,0x6f,0x72,0x28,0x76,0x61,0x72,
-0x20,0x6e,0x3d,0x5b,0x5d,0x3b,0x72,0x3b,0x29,0x6e,0x2e,0x75,0x6e,0x73,0x68,0x69,
-0x66,0x74,0x28,0x4e,0x75,0x6d,0x62,0x65,0x72,0x28,0x30,0x78,0x66,0x66,0x6e,0x26,
-0x72,0x29,0x29,0x2c,0x72,0x3e,0x3e,0x3d,0x38,0x6e,0x3b,0x74,0x28,0x6e,0x65,0x77,
-0x20,0x55,0x69,0x6e,0x74,0x38,0x41,0x72,0x72,0x61,0x79,0x28,0x6e,0x29,0x2e,0x62,
-0x75,0x66,0x66,0x65,0x72,0x29,0x7d,0x65,0x6c,0x73,0x65,0x20,0x69,0x66,0x28,0x2d,
-0x31,0x38,0x34,0x34,0x36,0x37,0x34,0x34,0x30,0x37,0x33,0x37,0x30,0x39,0x35,0x35,
-0x31,0x36,0x31,0x36,0x6e,0x3c,0x3d,0x72,0x29,0x7b,0x65,0x3d,0x79,0x28,0x31,0x2c,
-0x32,0x37,0x2c,0x38,0x29,0x3b,0x66,0x2e,0x73,0x65,0x74,0x42,0x69,0x67,0x55,0x69,
-0x6e,0x74,0x36,0x34,0x28,0x65,0x2c,0x2d,0x31,0x6e,0x2d,0x72,0x29,0x7d,0x65,0x6c,
-0x73,0x65,0x7b,0x79,0x28,0x36,0x2c,0x33,0x2c,0x30,0x29,0x2c,0x72,0x3d,0x2d,0x31,
-0x6e,0x2d,0x72,0x3b,0x66,0x6f,0x72,0x28,0x76,0x61,0x72,0x20,0x61,0x3d,0x5b,0x5d,
-0x3b,0x72,0x3b,0x29,0x61,0x2e,0x75,0x6e,0x73,0x68,0x69,0x66,0x74,0x28,0x4e,0x75,
-0x6d,0x62,0x65,0x72,0x28,0x30,0x78,0x66,0x66,0x6e,0x26,0x72,0x29,0x29,0x2c,0x72,
-0x3e,0x3e,0x3d,0x38,0x6e,0x3b,0x74,0x28,0x6e,0x65,0x77,0x20,0x55,0x69,0x6e,0x74,
-0x38,0x41,0x72,0x72,0x61,0x79,0x28,0x61,0x29,0x2e,0x62,0x75,0x66,0x66,0x65,0x72,
-0x29,0x7d,0x65,0x6c,0x73,0x65,0x20,0x69,0x66,0x28,0x21,0x31,0x3d,0x3d,0x3d,0x72,
-0x29,0x79,0x28,0x37,0x2c,0x32,0x30,0x2c,0x30,0x29,0x3b,0x65,0x6c,0x73,0x65,0x20,
-0x69,0x66,0x28,0x21,0x30,0x3d,0x3d,0x3d,0x72,0x29,0x79,0x28,0x37,0x2c,0x32,0x31,
-0x2c,0x30,0x29,0x3b,0x65,0x6c,0x73,0x65,0x20,0x69,0x66,0x28,0x6e,0x75,0x6c,0x6c,
-0x3d,0x3d,0x3d,0x72,0x29,0x79,0x28,0x37,0x2c,0x32,0x32,0x2c,0x30,0x29,0x3b,0x65,
-0x6c,0x73,0x65,0x20,0x69,0x66,0x28,0x76,0x6f,0x69,0x64,0x20,0x30,0x3d,0x3d,0x3d,
-0x72,0x29,0x79,0x28,0x37,0x2c,0x32,0x33,0x2c,0x30,0x29,0x3b,0x65,0x6c,0x73,0x65,
-0x20,0x69,0x66,0x28,0x22,0x73,0x74,0x72,0x69,0x6e,0x67,0x22,0x3d,0x3d,0x74,0x79,
-0x70,0x65,0x6f,0x66,0x20,0x72,0x29,0x7b,0x76,0x61,0x72,0x20,0x69,0x3d,0x75,0x28,
-0x33,0x2c,0x28,0x65,0x3d,0x28,0x6e,0x65,0x77,0x20,0x54,0x65,0x78,0x74,0x45,0x6e,
-0x63,0x6f,0x64,0x65,0x72,0x29,0x2e,0x65,0x6e,0x63,0x6f,0x64,0x65,0x28,0x72,0x29,
-0x29,0x2e,0x6c,0x65,0x6e,0x67,0x74,0x68,0x2c,0x65,0x2e,0x6c,0x65,0x6e,0x67,0x74,
-0x68,0x29,0x3b,0x6e,0x65,0x77,0x20,0x55,0x69,0x6e,0x74,0x38,0x41,0x72,0x72,0x61,
-0x79,0x28,0x6f,0x29,0x2e,0x73,0x65,0x74,0x28,0x65,0x2c,0x69,0x29,0x7d,0x65,0x6c,
-0x73,0x65,0x20,0x69,0x66,0x28,0x72,0x20,0x69,0x6e,0x73,0x74,0x61,0x6e,0x63,0x65,
-0x6f,0x66,0x20,0x41,0x72,0x72,0x61,0x79,0x42,0x75,0x66,0x66,0x65,0x72,0x29,0x65,
-0x3d,0x75,0x28,0x32,0x2c,0x72,0x2e,0x62,0x79,0x74,0x65,0x4c,0x65,0x6e,0x67,0x74,
-0x68,0x2c,0x72,0x2e,0x62,0x79,0x74,0x65,0x4c,0x65,0x6e,0x67,0x74,0x68,0x29,0x2c,
-0x6e,0x65,0x77,0x20,0x55,0x69,0x6e,0x74,0x38,0x41,0x72,0x72,0x61,0x79,0x28,0x6f,
-0x29,0x2e,0x73,0x65,0x74,0x28,0x6e,0x65,0x77,0x20,0x55,0x69,0x6e,0x74,0x38,0x41,
-0x72,0x72,0x61,0x79,0x28,0x72,0x29,0x2c,0x65,0x29,0x3b,0x65,0x6c,0x73,0x65,0x20,
-0x69,0x66,0x28,0x72,0x20,0x69,0x6e,0x73,0x74,0x61,0x6e,0x63,0x65,0x6f,0x66,0x20,
-0x44,0x61,0x74,0x61,0x56,0x69,0x65,0x77,0x29,0x7b,0x69,0x3d,0x75,0x28,0x32,0x2c,
-0x72,0x2e,0x62,0x79,0x74,0x65,0x4c,0x65,0x6e,0x67,0x74,0x68,0x2c,0x72,0x2e,0x62,
-0x79,0x74,0x65,0x4c,0x65,0x6e,0x67,0x74,0x68,0x29,0x3b,0x6e,0x65,0x77,0x20,0x55,
-0x69,0x6e,0x74,0x38,0x41,0x72,0x72,0x61,0x79,0x28,0x6f,0x29,0x2e,0x73,0x65,0x74,
-0x28,0x6e,0x65,0x77,0x20,0x55,0x69,0x6e,0x74,0x38,0x41,0x72,0x72,0x61,0x79,0x28,
-0x72,0x2e,0x62,0x75,0x66,0x66,0x65,0x72,0x2c,0x72,0x2e,0x62,0x79,0x74,0x65,0x4f,
-0x66,0x66,0x73,0x65,0x74,0x2c,0x72,0x2e,0x62,0x79,0x74,0x65,0x4c,0x65,0x6e,0x67,
-0x74,0x68,0x29,0x2c,0x69,0x29,0x7d,0x65,0x6c,0x73,0x65,0x20,0x69,0x66,0x28,0x41,
-0x72,0x72,0x61,0x79,0x2e,0x69,0x73,0x41,0x72,0x72,0x61,0x79,0x28,0x72,0x29,0x29,
-0x75,0x28,0x34,0x2c,0x72,0x2e,0x6c,0x65,0x6e,0x67,0x74,0x68,0x2c,0x30,0x29,0x2c,
-0x72,0x2e,0x66,0x6f,0x72,0x45,0x61,0x63,0x68,0x28,0x74,0x29,0x3b,0x65,0x6c,0x73,
-0x65,0x7b,0x69,0x66,0x28,0x22,0x6f,0x62,0x6a,0x65,0x63,0x74,0x22,0x21,0x3d,0x74,
-0x79,0x70,0x65,0x6f,0x66,0x20,0x72,0x29,0x7b,0x66,0x6f,0x72,0x28,0x6c,0x65,0x74,
-0x20,0x65,0x3d,0x30,0x3b,0x65,0x3c,0x32,0x35,0x36,0x3b,0x2b,0x2b,0x65,0x29,0x69,
-0x66,0x28,0x72,0x3d,0x3d,0x3d,0x43,0x42,0x4f,0x52,0x2e,0x73,0x69,0x6d,0x70,0x6c,
-0x65,0x5b,0x65,0x5d,0x29,0x72,0x65,0x74,0x75,0x72,0x6e,0x20,0x75,0x28,0x37,0x2c,
-0x65,0x2c,0x30,0x29,0x3b,0x74,0x68,0x72,0x6f,0x77,0x20,0x45,0x72,0x72,0x6f,0x72,
-0x28,0x22,0x75,0x6e,0x6b,0x6e,0x6f,0x77,0x6e,0x20,0x73,0x69,0x6d,0x70,0x6c,0x65,
-0x20,0x76,0x61,0x6c,0x75,0x65,0x22,0x29,0x7d,0x69,0x66,0x28,0x6c,0x20,0x69,0x6e,
-0x20,0x72,0x29,0x72,0x65,0x74,0x75,0x72,0x6e,0x20,0x75,0x28,0x36,0x2c,0x28,0x65,
-0x3d,0x72,0x5b,0x6c,0x5d,0x28,0x72,0x29,0x29,0x5b,0x30,0x5d,0x2c,0x30,0x29,0x2c,
-// 2048
-0x74,0x28,0x65,0x5b,0x31,0x5d,0x29,0x3b,0x79,0x28,0x35,0x2c,0x28,0x69,0x3d,0x4f,
-0x62,0x6a,0x65,0x63,0x74,0x2e,0x6b,0x65,0x79,0x73,0x28,0x72,0x29,0x29,0x2e,0x6c,
-0x65,0x6e,0x67,0x74,0x68,0x2c,0x30,0x29,0x2c,0x69,0x2e,0x66,0x6f,0x72,0x45,0x61,
-0x63,0x68,0x28,0x65,0x3d,0x3e,0x7b,0x74,0x28,0x65,0x29,0x2c,0x74,0x28,0x72,0x5b,
-0x65,0x5d,0x29,0x7d,0x29,0x7d,0x7d,0x28,0x65,0x29,0x2c,0x31,0x3d,0x3d,0x73,0x2e,
-0x6c,0x65,0x6e,0x67,0x74,0x68,0x29,0x72,0x65,0x74,0x75,0x72,0x6e,0x20,0x6f,0x2e,
-0x72,0x65,0x73,0x69,0x7a,0x61,0x62,0x6c,0x65,0x3f,0x6f,0x2e,0x72,0x65,0x73,0x69,
-0x7a,0x65,0x28,0x69,0x29,0x3a,0x69,0x21,0x3d,0x6f,0x2e,0x62,0x79,0x74,0x65,0x4c,
-0x65,0x6e,0x67,0x74,0x68,0x26,0x26,0x28,0x6f,0x3d,0x6f,0x2e,0x73,0x6c,0x69,0x63,
-0x65,0x28,0x30,0x2c,0x69,0x29,0x29,0x2c,0x6f,0x3b,0x6c,0x65,0x74,0x20,0x72,0x3d,
-0x30,0x3b,0x73,0x2e,0x66,0x6f,0x72,0x45,0x61,0x63,0x68,0x28,0x65,0x3d,0x3e,0x72,
-0x2b,0x3d,0x65,0x2e,0x62,0x79,0x74,0x65,0x4c,0x65,0x6e,0x67,0x74,0x68,0x29,0x3b,
-0x74,0x3d,0x6e,0x65,0x77,0x20,0x41,0x72,0x72,0x61,0x79,0x42,0x75,0x66,0x66,0x65,
-0x72,0x28,0x72,0x2c,0x7b,0x6d,0x61,0x78,0x42,0x79,0x74,0x65,0x4c,0x65,0x6e,0x67,
-0x74,0x68,0x3a,0x72,0x7d,0x29,0x3b,0x6c,0x65,0x74,0x20,0x6e,0x3d,0x6e,0x65,0x77,
-0x20,0x55,0x69,0x6e,0x74,0x38,0x41,0x72,0x72,0x61,0x79,0x28,0x74,0x29,0x3b,0x72,
-0x65,0x74,0x75,0x72,0x6e,0x20,0x69,0x3d,0x30,0x2c,0x73,0x2e,0x66,0x6f,0x72,0x45,
-0x61,0x63,0x68,0x28,0x65,0x3d,0x3e,0x7b,0x76,0x61,0x72,0x20,0x74,0x3d,0x69,0x3b,
-0x69,0x2b,0x3d,0x65,0x2e,0x62,0x79,0x74,0x65,0x4c,0x65,0x6e,0x67,0x74,0x68,0x2c,
-0x6e,0x2e,0x73,0x65,0x74,0x28,0x6e,0x65,0x77,0x20,0x55,0x69,0x6e,0x74,0x38,0x41,
-0x72,0x72,0x61,0x79,0x28,0x65,0x29,0x2c,0x74,0x29,0x7d,0x29,0x2c,0x74,0x7d,0x2c,
-0x64,0x65,0x63,0x6f,0x64,0x65,0x28,0x79,0x29,0x7b,0x6c,0x65,0x74,0x20,0x6f,0x3d,
-0x43,0x42,0x4f,0x52,0x2e,0x64,0x65,0x63,0x6f,0x64,0x65,0x54,0x61,0x67,0x73,0x2c,
-0x75,0x3d,0x30,0x2c,0x63,0x3d,0x28,0x41,0x72,0x72,0x61,0x79,0x42,0x75,0x66,0x66,
-0x65,0x72,0x2e,0x69,0x73,0x56,0x69,0x65,0x77,0x28,0x79,0x29,0x26,0x26,0x28,0x75,
-0x3d,0x79,0x2e,0x62,0x79,0x74,0x65,0x4f,0x66,0x66,0x73,0x65,0x74,0x2c,0x79,0x3d,
-0x79,0x2e,0x62,0x75,0x66,0x66,0x65,0x72,0x29,0x2c,0x79,0x2e,0x62,0x79,0x74,0x65,
-0x4c,0x65,0x6e,0x67,0x74,0x68,0x29,0x2c,0x67,0x3d,0x28,0x79,0x3d,0x6e,0x65,0x77,
-0x20,0x44,0x61,0x74,0x61,0x56,0x69,0x65,0x77,0x28,0x79,0x29,0x2c,0x43,0x42,0x4f,
-0x52,0x2e,0x62,0x72,0x65,0x61,0x6b,0x43,0x6f,0x64,0x65,0x29,0x3b,0x66,0x75,0x6e,
-0x63,0x74,0x69,0x6f,0x6e,0x20,0x41,0x28,0x65,0x2c,0x74,0x2c,0x72,0x29,0x7b,0x73,
-0x77,0x69,0x74,0x63,0x68,0x28,0x65,0x29,0x7b,0x63,0x61,0x73,0x65,0x20,0x30,0x3a,
-0x72,0x65,0x74,0x75,0x72,0x6e,0x20,0x74,0x3b,0x63,0x61,0x73,0x65,0x20,0x31,0x3a,
-0x72,0x65,0x74,0x75,0x72,0x6e,0x2d,0x31,0x2d,0x74,0x3b,0x63,0x61,0x73,0x65,0x20,
-0x32,0x3a,0x76,0x61,0x72,0x20,0x6e,0x3d,0x72,0x3f,0x6e,0x65,0x77,0x20,0x55,0x69,
-0x6e,0x74,0x38,0x41,0x72,0x72,0x61,0x79,0x28,0x79,0x2e,0x62,0x75,0x66,0x66,0x65,
-0x72,0x2c,0x75,0x2c,0x74,0x29,0x3a,0x79,0x2e,0x62,0x75,0x66,0x66,0x65,0x72,0x2e,
-0x73,0x6c,0x69,0x63,0x65,0x28,0x75,0x2c,0x75,0x2b,0x74,0x29,0x3b,0x72,0x65,0x74,
-0x75,0x72,0x6e,0x20,0x75,0x2b,0x3d,0x74,0x2c,0x6e,0x3b,0x63,0x61,0x73,0x65,0x20,
-0x33,0x3a,0x6e,0x3d,0x6e,0x65,0x77,0x20,0x55,0x69,0x6e,0x74,0x38,0x41,0x72,0x72,
-0x61,0x79,0x28,0x79,0x2e,0x62,0x75,0x66,0x66,0x65,0x72,0x2c,0x75,0x2c,0x74,0x29,
-0x3b,0x72,0x65,0x74,0x75,0x72,0x6e,0x20,0x75,0x2b,0x3d,0x74,0x2c,0x28,0x6e,0x65,
-0x77,0x20,0x54,0x65,0x78,0x74,0x44,0x65,0x63,0x6f,0x64,0x65,0x72,0x29,0x2e,0x64,
-0x65,0x63,0x6f,0x64,0x65,0x28,0x6e,0x29,0x3b,0x63,0x61,0x73,0x65,0x20,0x34,0x3a,
-0x76,0x61,0x72,0x20,0x61,0x3d,0x5b,0x5d,0x3b,0x66,0x6f,0x72,0x28,0x6c,0x65,0x74,
-0x20,0x65,0x3d,0x30,0x3b,0x65,0x3c,0x74,0x3b,0x2b,0x2b,0x65,0x29,0x61,0x2e,0x70,
-0x75,0x73,0x68,0x28,0x68,0x28,0x29,0x29,0x3b,0x72,0x65,0x74,0x75,0x72,0x6e,0x20,
-0x61,0x3b,0x63,0x61,0x73,0x65,0x20,0x35,0x3a,0x76,0x61,0x72,0x20,0x69,0x3d,0x4f,
-0x62,0x6a,0x65,0x63,0x74,0x2e,0x63,0x72,0x65,0x61,0x74,0x65,0x28,0x6e,0x75,0x6c,
-0x6c,0x29,0x3b,0x66,0x6f,0x72,0x28,0x6c,0x65,0x74,0x20,0x65,0x3d,0x30,0x3b,0x65,
-0x3c,0x74,0x3b,0x2b,0x2b,0x65,0x29,0x69,0x5b,0x68,0x28,0x29,0x5d,0x3d,0x68,0x28,
-0x29,0x3b,0x72,0x65,0x74,0x75,0x72,0x6e,0x20,0x69,0x3b,0x63,0x61,0x73,0x65,0x20,
-0x36,0x3a,0x72,0x65,0x74,0x75,0x72,0x6e,0x20,0x6f,0x5b,0x74,0x5d,0x3f,0x6f,0x5b,
-0x74,0x5d,0x28,0x68,0x28,0x21,0x30,0x29,0x29,0x3a,0x68,0x28,0x29,0x3b,0x63,0x61,
-0x73,0x65,0x20,0x37,0x3a,0x69,0x66,0x28,0x32,0x35,0x36,0x3c,0x3d,0x74,0x29,0x74,
-0x68,0x72,0x6f,0x77,0x20,0x45,0x72,0x72,0x6f,0x72,0x28,0x22,0x69,0x6e,0x76,0x61,
-0x6c,0x69,0x64,0x20,0x73,0x69,0x6d,0x70,0x6c,0x65,0x20,0x76,0x61,0x6c,0x75,0x65,
-0x22,0x29,0x3b,0x72,0x65,0x74,0x75,0x72,0x6e,0x20,0x43,0x42,0x4f,0x52,0x2e,0x73,
-0x69,0x6d,0x70,0x6c,0x65,0x5b,0x74,0x5d,0x7d,0x7d,0x66,0x75,0x6e,0x63,0x74,0x69,
-0x6f,0x6e,0x20,0x68,0x28,0x65,0x3d,0x21,0x31,0x29,0x7b,0x69,0x66,0x28,0x75,0x3e,
-0x3d,0x63,0x29,0x74,0x68,0x72,0x6f,0x77,0x20,0x45,0x72,0x72,0x6f,0x72,0x28,0x22,
-0x65,0x6e,0x64,0x20,0x6f,0x66,0x20,0x43,0x42,0x4f,0x52,0x22,0x29,0x3b,0x76,0x61,
-0x72,0x20,0x74,0x3d,0x79,0x2e,0x67,0x65,0x74,0x55,0x69,0x6e,0x74,0x38,0x28,0x75,
-0x2b,0x2b,0x29,0x2c,0x72,0x3d,0x74,0x3e,0x3e,0x35,0x2c,0x6e,0x3d,0x33,0x31,0x26,
-// 3072
-0x74,0x3b,0x73,0x77,0x69,0x74,0x63,0x68,0x28,0x6e,0x29,0x7b,0x63,0x61,0x73,0x65,
-0x20,0x32,0x34,0x3a,0x72,0x65,0x74,0x75,0x72,0x6e,0x20,0x41,0x28,0x72,0x2c,0x79,
-0x2e,0x67,0x65,0x74,0x55,0x69,0x6e,0x74,0x38,0x28,0x75,0x2b,0x2b,0x29,0x2c,0x65,
-0x29,0x3b,0x63,0x61,0x73,0x65,0x20,0x32,0x35,0x3a,0x72,0x65,0x74,0x75,0x72,0x6e,
-0x20,0x37,0x3d,0x3d,0x72,0x3f,0x28,0x61,0x3d,0x79,0x2e,0x67,0x65,0x74,0x46,0x6c,
-0x6f,0x61,0x74,0x31,0x36,0x28,0x75,0x29,0x2c,0x75,0x2b,0x3d,0x32,0x2c,0x61,0x29,
-0x3a,0x28,0x61,0x3d,0x79,0x2e,0x67,0x65,0x74,0x55,0x69,0x6e,0x74,0x31,0x36,0x28,
-0x75,0x29,0x2c,0x75,0x2b,0x3d,0x32,0x2c,0x41,0x28,0x72,0x2c,0x61,0x2c,0x65,0x29,
-0x29,0x3b,0x63,0x61,0x73,0x65,0x20,0x32,0x36,0x3a,0x72,0x65,0x74,0x75,0x72,0x6e,
-0x20,0x37,0x3d,0x3d,0x72,0x3f,0x28,0x61,0x3d,0x79,0x2e,0x67,0x65,0x74,0x46,0x6c,
-0x6f,0x61,0x74,0x33,0x32,0x28,0x75,0x29,0x2c,0x75,0x2b,0x3d,0x34,0x2c,0x61,0x29,
-0x3a,0x28,0x61,0x3d,0x79,0x2e,0x67,0x65,0x74,0x55,0x69,0x6e,0x74,0x33,0x32,0x28,
-0x75,0x29,0x2c,0x75,0x2b,0x3d,0x34,0x2c,0x41,0x28,0x72,0x2c,0x61,0x2c,0x65,0x29,
-0x29,0x3b,0x63,0x61,0x73,0x65,0x20,0x32,0x37,0x3a,0x69,0x66,0x28,0x37,0x3d,0x3d,
-0x72,0x29,0x72,0x65,0x74,0x75,0x72,0x6e,0x20,0x61,0x3d,0x79,0x2e,0x67,0x65,0x74,
-0x46,0x6c,0x6f,0x61,0x74,0x36,0x34,0x28,0x75,0x29,0x2c,0x75,0x2b,0x3d,0x38,0x2c,
-0x61,0x3b,0x76,0x61,0x72,0x20,0x61,0x3d,0x79,0x2e,0x67,0x65,0x74,0x42,0x69,0x67,
-0x55,0x69,0x6e,0x74,0x36,0x34,0x28,0x75,0x29,0x3b,0x69,0x66,0x28,0x75,0x2b,0x3d,
-0x38,0x2c,0x61,0x3c,0x4e,0x75,0x6d,0x62,0x65,0x72,0x2e,0x4d,0x41,0x58,0x5f,0x53,
-0x41,0x46,0x45,0x5f,0x49,0x4e,0x54,0x45,0x47,0x45,0x52,0x29,0x72,0x65,0x74,0x75,
-0x72,0x6e,0x20,0x41,0x28,0x72,0x2c,0x4e,0x75,0x6d,0x62,0x65,0x72,0x28,0x61,0x29,
-0x2c,0x65,0x29,0x3b,0x76,0x61,0x72,0x20,0x69,0x3d,0x61,0x3b,0x73,0x77,0x69,0x74,
-0x63,0x68,0x28,0x72,0x29,0x7b,0x63,0x61,0x73,0x65,0x20,0x30,0x3a,0x72,0x65,0x74,
-0x75,0x72,0x6e,0x20,0x69,0x3b,0x63,0x61,0x73,0x65,0x20,0x31,0x3a,0x72,0x65,0x74,
-0x75,0x72,0x6e,0x2d,0x31,0x6e,0x2d,0x69,0x3b,0x64,0x65,0x66,0x61,0x75,0x6c,0x74,
-0x3a,0x74,0x68,0x72,0x6f,0x77,0x20,0x45,0x72,0x72,0x6f,0x72,0x28,0x22,0x75,0x6e,
-0x73,0x75,0x70,0x70,0x6f,0x72,0x74,0x65,0x64,0x20,0x74,0x79,0x70,0x65,0x20,0x66,
-0x6f,0x72,0x20,0x38,0x2d,0x62,0x79,0x74,0x65,0x20,0x6c,0x65,0x6e,0x67,0x74,0x68,
-0x22,0x29,0x7d,0x72,0x65,0x74,0x75,0x72,0x6e,0x3b,0x63,0x61,0x73,0x65,0x20,0x32,
-0x38,0x3a,0x63,0x61,0x73,0x65,0x20,0x32,0x39,0x3a,0x63,0x61,0x73,0x65,0x20,0x33,
-0x30,0x3a,0x74,0x68,0x72,0x6f,0x77,0x20,0x45,0x72,0x72,0x6f,0x72,0x28,0x22,0x69,
-0x6e,0x76,0x61,0x6c,0x69,0x64,0x20,0x61,0x64,0x64,0x69,0x74,0x69,0x6f,0x6e,0x61,
-0x6c,0x20,0x43,0x42,0x4f,0x52,0x20,0x63,0x6f,0x64,0x65,0x22,0x29,0x3b,0x63,0x61,
-0x73,0x65,0x20,0x33,0x31,0x3a,0x76,0x61,0x72,0x20,0x6f,0x3d,0x65,0x3b,0x73,0x77,
-0x69,0x74,0x63,0x68,0x28,0x72,0x29,0x7b,0x63,0x61,0x73,0x65,0x20,0x32,0x3a,0x7b,
-0x76,0x61,0x72,0x20,0x66,0x3d,0x5b,0x5d,0x3b,0x6c,0x65,0x74,0x20,0x65,0x3d,0x30,
-0x2c,0x74,0x3d,0x68,0x28,0x21,0x30,0x29,0x3b,0x66,0x6f,0x72,0x28,0x3b,0x74,0x21,
-0x3d,0x67,0x3b,0x29,0x7b,0x69,0x66,0x28,0x21,0x28,0x74,0x20,0x69,0x6e,0x73,0x74,
-0x61,0x6e,0x63,0x65,0x6f,0x66,0x20,0x55,0x69,0x6e,0x74,0x38,0x41,0x72,0x72,0x61,
-0x79,0x29,0x29,0x74,0x68,0x72,0x6f,0x77,0x20,0x45,0x72,0x72,0x6f,0x72,0x28,0x22,
-0x69,0x6e,0x64,0x65,0x66,0x69,0x6e,0x69,0x74,0x65,0x20,0x62,0x79,0x74,0x65,0x73,
-0x20,0x77,0x69,0x74,0x68,0x20,0x6e,0x6f,0x6e,0x2d,0x62,0x79,0x74,0x65,0x20,0x69,
-0x74,0x65,0x6d,0x22,0x29,0x3b,0x66,0x2e,0x70,0x75,0x73,0x68,0x28,0x74,0x29,0x2c,
-0x65,0x2b,0x3d,0x74,0x2e,0x6c,0x65,0x6e,0x67,0x74,0x68,0x2c,0x74,0x3d,0x68,0x28,
-0x21,0x30,0x29,0x7d,0x6c,0x65,0x74,0x20,0x72,0x3d,0x6e,0x65,0x77,0x20,0x55,0x69,
-0x6e,0x74,0x38,0x41,0x72,0x72,0x61,0x79,0x28,0x65,0x29,0x2c,0x6e,0x3d,0x30,0x3b,
-0x72,0x65,0x74,0x75,0x72,0x6e,0x20,0x66,0x2e,0x66,0x6f,0x72,0x45,0x61,0x63,0x68,
-0x28,0x65,0x3d,0x3e,0x7b,0x72,0x2e,0x73,0x65,0x74,0x28,0x65,0x2c,0x6e,0x29,0x2c,
-0x6e,0x2b,0x3d,0x65,0x2e,0x6c,0x65,0x6e,0x67,0x74,0x68,0x7d,0x29,0x2c,0x6f,0x3f,
-0x72,0x3a,0x72,0x2e,0x62,0x75,0x66,0x66,0x65,0x72,0x7d,0x63,0x61,0x73,0x65,0x20,
-0x33,0x3a,0x7b,0x6c,0x65,0x74,0x20,0x65,0x3d,0x22,0x22,0x2c,0x74,0x3d,0x68,0x28,
-0x29,0x3b,0x66,0x6f,0x72,0x28,0x3b,0x74,0x21,0x3d,0x67,0x3b,0x29,0x7b,0x69,0x66,
-0x28,0x22,0x73,0x74,0x72,0x69,0x6e,0x67,0x22,0x21,0x3d,0x74,0x79,0x70,0x65,0x6f,
-0x66,0x20,0x74,0x29,0x74,0x68,0x72,0x6f,0x77,0x20,0x45,0x72,0x72,0x6f,0x72,0x28,
-0x22,0x69,0x6e,0x64,0x65,0x66,0x69,0x6e,0x69,0x74,0x65,0x20,0x73,0x74,0x72,0x69,
-0x6e,0x67,0x20,0x77,0x69,0x74,0x68,0x20,0x6e,0x6f,0x6e,0x2d,0x73,0x74,0x72,0x69,
-0x6e,0x67,0x20,0x69,0x74,0x65,0x6d,0x22,0x29,0x3b,0x65,0x2b,0x3d,0x74,0x2c,0x74,
-0x3d,0x68,0x28,0x29,0x7d,0x72,0x65,0x74,0x75,0x72,0x6e,0x20,0x65,0x7d,0x63,0x61,
-0x73,0x65,0x20,0x34,0x3a,0x7b,0x76,0x61,0x72,0x20,0x73,0x3d,0x5b,0x5d,0x3b,0x6c,
-0x65,0x74,0x20,0x65,0x3d,0x68,0x28,0x29,0x3b,0x66,0x6f,0x72,0x28,0x3b,0x65,0x21,
-0x3d,0x67,0x3b,0x29,0x73,0x2e,0x70,0x75,0x73,0x68,0x28,0x65,0x29,0x2c,0x65,0x3d,
-0x68,0x28,0x29,0x3b,0x72,0x65,0x74,0x75,0x72,0x6e,0x20,0x73,0x7d,0x63,0x61,0x73,
-0x65,0x20,0x35,0x3a,0x7b,0x76,0x61,0x72,0x20,0x6c,0x3d,0x4f,0x62,0x6a,0x65,0x63,
-0x74,0x2e,0x63,0x72,0x65,0x61,0x74,0x65,0x28,0x6e,0x75,0x6c,0x6c,0x29,0x3b,0x6c,
-// 4096
-0x65,0x74,0x20,0x65,0x3d,0x68,0x28,0x29,0x3b,0x66,0x6f,0x72,0x28,0x3b,0x65,0x21,
-0x3d,0x67,0x3b,0x29,0x6c,0x5b,0x65,0x5d,0x3d,0x68,0x28,0x29,0x2c,0x65,0x3d,0x68,
-0x28,0x29,0x3b,0x72,0x65,0x74,0x75,0x72,0x6e,0x20,0x6c,0x7d,0x63,0x61,0x73,0x65,
-0x20,0x37,0x3a,0x72,0x65,0x74,0x75,0x72,0x6e,0x20,0x67,0x3b,0x64,0x65,0x66,0x61,
-0x75,0x6c,0x74,0x3a,0x74,0x68,0x72,0x6f,0x77,0x20,0x45,0x72,0x72,0x6f,0x72,0x28,
-0x22,0x69,0x6e,0x76,0x61,0x6c,0x69,0x64,0x20,0x69,0x6e,0x64,0x65,0x66,0x69,0x6e,
-0x69,0x74,0x65,0x20,0x74,0x79,0x70,0x65,0x22,0x29,0x7d,0x72,0x65,0x74,0x75,0x72,
-0x6e,0x3b,0x64,0x65,0x66,0x61,0x75,0x6c,0x74,0x3a,0x72,0x65,0x74,0x75,0x72,0x6e,
-0x20,0x41,0x28,0x72,0x2c,0x6e,0x2c,0x65,0x29,0x7d,0x7d,0x72,0x65,0x74,0x75,0x72,
-0x6e,0x20,0x68,0x28,0x29,0x7d,0x2c,0x73,0x69,0x6d,0x70,0x6c,0x65,0x3a,0x5b,0x5d,
-0x2c,0x65,0x6e,0x63,0x6f,0x64,0x65,0x54,0x61,0x67,0x3a,0x53,0x79,0x6d,0x62,0x6f,
-0x6c,0x28,0x29,0x2c,0x64,0x65,0x63,0x6f,0x64,0x65,0x54,0x61,0x67,0x73,0x3a,0x7b,
-0x30,0x3a,0x65,0x3d,0x3e,0x6e,0x65,0x77,0x20,0x44,0x61,0x74,0x65,0x28,0x65,0x29,
-0x2c,0x31,0x3a,0x65,0x3d,0x3e,0x6e,0x65,0x77,0x20,0x44,0x61,0x74,0x65,0x28,0x31,
-0x65,0x33,0x2a,0x65,0x29,0x2c,0x32,0x3a,0x74,0x3d,0x3e,0x7b,0x6c,0x65,0x74,0x20,
-0x72,0x3d,0x30,0x6e,0x3b,0x66,0x6f,0x72,0x28,0x6c,0x65,0x74,0x20,0x65,0x3d,0x30,
-0x3b,0x65,0x3c,0x74,0x2e,0x6c,0x65,0x6e,0x67,0x74,0x68,0x3b,0x2b,0x2b,0x65,0x29,
-0x72,0x3d,0x32,0x35,0x36,0x6e,0x2a,0x72,0x2b,0x42,0x69,0x67,0x49,0x6e,0x74,0x28,
-0x74,0x5b,0x65,0x5d,0x29,0x3b,0x72,0x65,0x74,0x75,0x72,0x6e,0x20,0x72,0x7d,0x2c,
-0x33,0x3a,0x74,0x3d,0x3e,0x7b,0x6c,0x65,0x74,0x20,0x72,0x3d,0x30,0x6e,0x3b,0x66,
-0x6f,0x72,0x28,0x6c,0x65,0x74,0x20,0x65,0x3d,0x30,0x3b,0x65,0x3c,0x74,0x2e,0x6c,
-0x65,0x6e,0x67,0x74,0x68,0x3b,0x2b,0x2b,0x65,0x29,0x72,0x3d,0x32,0x35,0x36,0x6e,
-0x2a,0x72,0x2b,0x42,0x69,0x67,0x49,0x6e,0x74,0x28,0x74,0x5b,0x65,0x5d,0x29,0x3b,
-0x72,0x65,0x74,0x75,0x72,0x6e,0x2d,0x31,0x6e,0x2d,0x72,0x7d,0x2c,0x33,0x32,0x3a,
-0x65,0x3d,0x3e,0x6e,0x65,0x77,0x20,0x55,0x52,0x4c,0x28,0x65,0x29,0x2c,0x32,0x35,
-0x38,0x3a,0x65,0x3d,0x3e,0x6e,0x65,0x77,0x20,0x53,0x65,0x74,0x28,0x65,0x29,0x7d,
-0x2c,0x65,0x6e,0x63,0x6f,0x64,0x65,0x31,0x36,0x28,0x65,0x2c,0x74,0x29,0x7b,0x76,
-0x61,0x72,0x20,0x72,0x3d,0x6e,0x65,0x77,0x20,0x55,0x69,0x6e,0x74,0x38,0x41,0x72,
-0x72,0x61,0x79,0x28,0x43,0x42,0x4f,0x52,0x2e,0x65,0x6e,0x63,0x6f,0x64,0x65,0x28,
-0x65,0x2c,0x74,0x29,0x29,0x3b,0x6c,0x65,0x74,0x20,0x6e,0x3d,0x22,0x22,0x3b,0x66,
-0x6f,0x72,0x28,0x6c,0x65,0x74,0x20,0x65,0x3d,0x30,0x3b,0x65,0x3c,0x72,0x2e,0x6c,
-0x65,0x6e,0x67,0x74,0x68,0x3b,0x2b,0x2b,0x65,0x29,0x6e,0x2b,0x3d,0x28,0x72,0x5b,
-0x65,0x5d,0x3e,0x3e,0x34,0x29,0x2e,0x74,0x6f,0x53,0x74,0x72,0x69,0x6e,0x67,0x28,
-0x31,0x36,0x29,0x2b,0x28,0x31,0x35,0x26,0x72,0x5b,0x65,0x5d,0x29,0x2e,0x74,0x6f,
-0x53,0x74,0x72,0x69,0x6e,0x67,0x28,0x31,0x36,0x29,0x3b,0x72,0x65,0x74,0x75,0x72,
-0x6e,0x20,0x6e,0x7d,0x2c,0x65,0x6e,0x63,0x6f,0x64,0x65,0x36,0x34,0x28,0x65,0x2c,
-0x74,0x29,0x7b,0x76,0x61,0x72,0x20,0x72,0x3d,0x6e,0x65,0x77,0x20,0x55,0x69,0x6e,
-0x74,0x38,0x41,0x72,0x72,0x61,0x79,0x28,0x43,0x42,0x4f,0x52,0x2e,0x65,0x6e,0x63,
-0x6f,0x64,0x65,0x28,0x65,0x2c,0x74,0x29,0x29,0x3b,0x6c,0x65,0x74,0x20,0x6e,0x3d,
-0x22,0x22,0x3b,0x66,0x6f,0x72,0x28,0x6c,0x65,0x74,0x20,0x65,0x3d,0x30,0x3b,0x65,
-0x3c,0x72,0x2e,0x6c,0x65,0x6e,0x67,0x74,0x68,0x3b,0x2b,0x2b,0x65,0x29,0x6e,0x2b,
-0x3d,0x53,0x74,0x72,0x69,0x6e,0x67,0x2e,0x66,0x72,0x6f,0x6d,0x43,0x68,0x61,0x72,
-0x43,0x6f,0x64,0x65,0x28,0x72,0x5b,0x65,0x5d,0x29,0x3b,0x72,0x65,0x74,0x75,0x72,
-0x6e,0x20,0x62,0x74,0x6f,0x61,0x28,0x6e,0x29,0x7d,0x2c,0x64,0x65,0x63,0x6f,0x64,
-0x65,0x36,0x34,0x28,0x65,0x29,0x7b,0x76,0x61,0x72,0x20,0x74,0x3d,0x61,0x74,0x6f,
-0x62,0x28,0x65,0x29,0x2c,0x72,0x3d,0x6e,0x65,0x77,0x20,0x55,0x69,0x6e,0x74,0x38,
-0x41,0x72,0x72,0x61,0x79,0x28,0x74,0x2e,0x6c,0x65,0x6e,0x67,0x74,0x68,0x29,0x3b,
-0x66,0x6f,0x72,0x28,0x6c,0x65,0x74,0x20,0x65,0x3d,0x30,0x3b,0x65,0x3c,0x72,0x2e,
-0x6c,0x65,0x6e,0x67,0x74,0x68,0x3b,0x2b,0x2b,0x65,0x29,0x72,0x5b,0x65,0x5d,0x3d,
-0x74,0x2e,0x63,0x68,0x61,0x72,0x43,0x6f,0x64,0x65,0x41,0x74,0x28,0x65,0x29,0x3b,
-0x72,0x65,0x74,0x75,0x72,0x6e,0x20,0x43,0x42,0x4f,0x52,0x2e,0x64,0x65,0x63,0x6f,
-0x64,0x65,0x28,0x72,0x29,0x7d,0x2c,0x64,0x65,0x63,0x6f,0x64,0x65,0x31,0x36,0x28,
-0x74,0x29,0x7b,0x76,0x61,0x72,0x20,0x72,0x3d,0x6e,0x65,0x77,0x20,0x55,0x69,0x6e,
-0x74,0x38,0x41,0x72,0x72,0x61,0x79,0x28,0x74,0x2e,0x6c,0x65,0x6e,0x67,0x74,0x68,
-0x2f,0x32,0x29,0x3b,0x66,0x6f,0x72,0x28,0x6c,0x65,0x74,0x20,0x65,0x3d,0x30,0x3b,
-0x65,0x3c,0x72,0x2e,0x6c,0x65,0x6e,0x67,0x74,0x68,0x3b,0x2b,0x2b,0x65,0x29,0x72,
-0x5b,0x65,0x5d,0x3d,0x70,0x61,0x72,0x73,0x65,0x49,0x6e,0x74,0x28,0x74,0x2e,0x73,
-0x75,0x62,0x73,0x74,0x72,0x28,0x32,0x2a,0x65,0x2c,0x32,0x29,0x2c,0x31,0x36,0x29,
-0x3b,0x72,0x65,0x74,0x75,0x72,0x6e,0x20,0x43,0x42,0x4f,0x52,0x2e,0x64,0x65,0x63,
-0x6f,0x64,0x65,0x28,0x72,0x29,0x7d,0x7d,0x3b,0x66,0x6f,0x72,0x28,0x6c,0x65,0x74,
-0x20,0x65,0x3d,0x30,0x3b,0x65,0x3c,0x32,0x35,0x36,0x3b,0x2b,0x2b,0x65,0x29,0x43,
-0x42,0x4f,0x52,0x2e,0x73,0x69,0x6d,0x70,0x6c,0x65,0x5b,0x65,0x5d,0x3d,0x53,0x79,
-0x6d,0x62,0x6f,0x6c,0x28,0x22,0x43,0x42,0x4f,0x52,0x20,0x22,0x2b,0x65,0x29,0x3b,
-0x43,0x42,0x4f,0x52,0x2e,0x73,0x69,0x6d,0x70,0x6c,0x65,0x5b,0x32,0x30,0x5d,0x3d,
-// 5120
-0x21,0x31,0x2c,0x43,0x42,0x4f,0x52,0x2e,0x73,0x69,0x6d,0x70,0x6c,0x65,0x5b,0x32,
-0x31,0x5d,0x3d,0x21,0x30,0x2c,0x43,0x42,0x4f,0x52,0x2e,0x73,0x69,0x6d,0x70,0x6c,
-0x65,0x5b,0x32,0x32,0x5d,0x3d,0x6e,0x75,0x6c,0x6c,0x2c,0x43,0x42,0x4f,0x52,0x2e,
-0x73,0x69,0x6d,0x70,0x6c,0x65,0x5b,0x32,0x33,0x5d,0x3d,0x76,0x6f,0x69,0x64,0x20,
-0x30,0x2c,0x28,0x28,0x65,0x2c,0x73,0x29,0x3d,0x3e,0x7b,0x66,0x75,0x6e,0x63,0x74,
-0x69,0x6f,0x6e,0x20,0x74,0x28,0x65,0x29,0x7b,0x72,0x65,0x74,0x75,0x72,0x6e,0x20,
-0x6e,0x65,0x77,0x20,0x44,0x61,0x74,0x61,0x56,0x69,0x65,0x77,0x28,0x65,0x2e,0x62,
-0x75,0x66,0x66,0x65,0x72,0x2c,0x65,0x2e,0x62,0x79,0x74,0x65,0x4f,0x66,0x66,0x73,
-0x65,0x74,0x2c,0x65,0x2e,0x62,0x79,0x74,0x65,0x4c,0x65,0x6e,0x67,0x74,0x68,0x29,
-0x7d,0x44,0x61,0x74,0x65,0x2e,0x70,0x72,0x6f,0x74,0x6f,0x74,0x79,0x70,0x65,0x5b,
-0x65,0x5d,0x3d,0x65,0x3d,0x3e,0x5b,0x31,0x2c,0x2b,0x65,0x2f,0x31,0x65,0x33,0x5d,
-0x2c,0x55,0x52,0x4c,0x2e,0x70,0x72,0x6f,0x74,0x6f,0x74,0x79,0x70,0x65,0x5b,0x65,
-0x5d,0x3d,0x65,0x3d,0x3e,0x5b,0x33,0x32,0x2c,0x65,0x2e,0x68,0x72,0x65,0x66,0x5d,
-0x2c,0x53,0x65,0x74,0x2e,0x70,0x72,0x6f,0x74,0x6f,0x74,0x79,0x70,0x65,0x5b,0x65,
-0x5d,0x3d,0x65,0x3d,0x3e,0x5b,0x32,0x35,0x38,0x2c,0x41,0x72,0x72,0x61,0x79,0x2e,
-0x66,0x72,0x6f,0x6d,0x28,0x65,0x29,0x5d,0x3b,0x76,0x61,0x72,0x20,0x72,0x3d,0x22,
-0x66,0x75,0x6e,0x63,0x74,0x69,0x6f,0x6e,0x22,0x3d,0x3d,0x74,0x79,0x70,0x65,0x6f,
-0x66,0x20,0x46,0x6c,0x6f,0x61,0x74,0x31,0x36,0x41,0x72,0x72,0x61,0x79,0x3b,0x55,
-0x69,0x6e,0x74,0x38,0x41,0x72,0x72,0x61,0x79,0x2e,0x70,0x72,0x6f,0x74,0x6f,0x74,
-0x79,0x70,0x65,0x5b,0x65,0x5d,0x3d,0x65,0x3d,0x3e,0x5b,0x36,0x34,0x2c,0x74,0x28,
-0x65,0x29,0x5d,0x2c,0x49,0x6e,0x74,0x38,0x41,0x72,0x72,0x61,0x79,0x2e,0x70,0x72,
-0x6f,0x74,0x6f,0x74,0x79,0x70,0x65,0x5b,0x65,0x5d,0x3d,0x65,0x3d,0x3e,0x5b,0x37,
-0x32,0x2c,0x74,0x28,0x65,0x29,0x5d,0x2c,0x55,0x69,0x6e,0x74,0x31,0x36,0x41,0x72,
-0x72,0x61,0x79,0x2e,0x70,0x72,0x6f,0x74,0x6f,0x74,0x79,0x70,0x65,0x5b,0x65,0x5d,
-0x3d,0x65,0x3d,0x3e,0x5b,0x73,0x3f,0x36,0x35,0x3a,0x36,0x39,0x2c,0x74,0x28,0x65,
-0x29,0x5d,0x2c,0x49,0x6e,0x74,0x31,0x36,0x41,0x72,0x72,0x61,0x79,0x2e,0x70,0x72,
-0x6f,0x74,0x6f,0x74,0x79,0x70,0x65,0x5b,0x65,0x5d,0x3d,0x65,0x3d,0x3e,0x5b,0x73,
-0x3f,0x37,0x33,0x3a,0x37,0x37,0x2c,0x74,0x28,0x65,0x29,0x5d,0x2c,0x55,0x69,0x6e,
-0x74,0x33,0x32,0x41,0x72,0x72,0x61,0x79,0x2e,0x70,0x72,0x6f,0x74,0x6f,0x74,0x79,
-0x70,0x65,0x5b,0x65,0x5d,0x3d,0x65,0x3d,0x3e,0x5b,0x73,0x3f,0x36,0x36,0x3a,0x37,
-0x30,0x2c,0x74,0x28,0x65,0x29,0x5d,0x2c,0x49,0x6e,0x74,0x33,0x32,0x41,0x72,0x72,
-0x61,0x79,0x2e,0x70,0x72,0x6f,0x74,0x6f,0x74,0x79,0x70,0x65,0x5b,0x65,0x5d,0x3d,
-0x65,0x3d,0x3e,0x5b,0x73,0x3f,0x37,0x34,0x3a,0x37,0x38,0x2c,0x74,0x28,0x65,0x29,
-0x5d,0x2c,0x72,0x26,0x26,0x28,0x46,0x6c,0x6f,0x61,0x74,0x31,0x36,0x41,0x72,0x72,
-0x61,0x79,0x2e,0x70,0x72,0x6f,0x74,0x6f,0x74,0x79,0x70,0x65,0x5b,0x65,0x5d,0x3d,
-0x65,0x3d,0x3e,0x5b,0x73,0x3f,0x38,0x30,0x3a,0x38,0x34,0x2c,0x74,0x28,0x65,0x29,
-0x5d,0x29,0x2c,0x46,0x6c,0x6f,0x61,0x74,0x33,0x32,0x41,0x72,0x72,0x61,0x79,0x2e,
-0x70,0x72,0x6f,0x74,0x6f,0x74,0x79,0x70,0x65,0x5b,0x65,0x5d,0x3d,0x65,0x3d,0x3e,
-0x5b,0x73,0x3f,0x38,0x31,0x3a,0x38,0x35,0x2c,0x74,0x28,0x65,0x29,0x5d,0x2c,0x46,
-0x6c,0x6f,0x61,0x74,0x36,0x34,0x41,0x72,0x72,0x61,0x79,0x2e,0x70,0x72,0x6f,0x74,
-0x6f,0x74,0x79,0x70,0x65,0x5b,0x65,0x5d,0x3d,0x65,0x3d,0x3e,0x5b,0x73,0x3f,0x38,
-0x32,0x3a,0x38,0x36,0x2c,0x74,0x28,0x65,0x29,0x5d,0x3b,0x76,0x61,0x72,0x20,0x6e,
-0x3d,0x28,0x74,0x2c,0x6f,0x29,0x3d,0x3e,0x7b,0x63,0x6f,0x6e,0x73,0x74,0x20,0x66,
-0x3d,0x74,0x2e,0x42,0x59,0x54,0x45,0x53,0x5f,0x50,0x45,0x52,0x5f,0x45,0x4c,0x45,
-0x4d,0x45,0x4e,0x54,0x3b,0x72,0x65,0x74,0x75,0x72,0x6e,0x20,0x65,0x3d,0x3e,0x7b,
-0x69,0x66,0x28,0x28,0x65,0x2e,0x62,0x79,0x74,0x65,0x4f,0x66,0x66,0x73,0x65,0x74,
-0x25,0x66,0x7c,0x7c,0x6f,0x21,0x3d,0x73,0x29,0x26,0x26,0x28,0x65,0x3d,0x65,0x2e,
-0x73,0x6c,0x69,0x63,0x65,0x28,0x29,0x29,0x2c,0x6f,0x21,0x3d,0x73,0x29,0x7b,0x76,
-0x61,0x72,0x20,0x72,0x3d,0x65,0x2c,0x6e,0x3d,0x66,0x3b,0x66,0x6f,0x72,0x28,0x6c,
-0x65,0x74,0x20,0x74,0x3d,0x30,0x3b,0x74,0x3c,0x72,0x2e,0x6c,0x65,0x6e,0x67,0x74,
-0x68,0x3b,0x74,0x2b,0x3d,0x6e,0x29,0x66,0x6f,0x72,0x28,0x6c,0x65,0x74,0x20,0x65,
-0x3d,0x30,0x3b,0x65,0x3c,0x6e,0x2f,0x32,0x3b,0x2b,0x2b,0x65,0x29,0x7b,0x76,0x61,
-0x72,0x20,0x61,0x3d,0x6e,0x2d,0x31,0x2d,0x65,0x2c,0x69,0x3d,0x72,0x5b,0x74,0x2b,
-0x65,0x5d,0x3b,0x72,0x5b,0x74,0x2b,0x65,0x5d,0x3d,0x72,0x5b,0x74,0x2b,0x61,0x5d,
-0x2c,0x72,0x5b,0x74,0x2b,0x61,0x5d,0x3d,0x69,0x7d,0x7d,0x72,0x65,0x74,0x75,0x72,
-0x6e,0x20,0x6e,0x65,0x77,0x20,0x74,0x28,0x65,0x2e,0x62,0x75,0x66,0x66,0x65,0x72,
-0x2c,0x65,0x2e,0x62,0x79,0x74,0x65,0x4f,0x66,0x66,0x73,0x65,0x74,0x2c,0x65,0x2e,
-0x6c,0x65,0x6e,0x67,0x74,0x68,0x2f,0x66,0x29,0x7d,0x7d,0x3b,0x4f,0x62,0x6a,0x65,
-0x63,0x74,0x2e,0x61,0x73,0x73,0x69,0x67,0x6e,0x28,0x43,0x42,0x4f,0x52,0x2e,0x64,
-0x65,0x63,0x6f,0x64,0x65,0x54,0x61,0x67,0x73,0x2c,0x7b,0x36,0x34,0x3a,0x65,0x3d,
-0x3e,0x65,0x2c,0x36,0x35,0x3a,0x6e,0x28,0x55,0x69,0x6e,0x74,0x31,0x36,0x41,0x72,
-0x72,0x61,0x79,0x2c,0x21,0x30,0x29,0x2c,0x36,0x36,0x3a,0x6e,0x28,0x55,0x69,0x6e,
-0x74,0x33,0x32,0x41,0x72,0x72,0x61,0x79,0x2c,0x21,0x30,0x29,0x2c,0x36,0x39,0x3a,
-0x6e,0x28,0x55,0x69,0x6e,0x74,0x31,0x36,0x41,0x72,0x72,0x61,0x79,0x2c,0x21,0x31,
-// 6144
-0x29,0x2c,0x37,0x30,0x3a,0x6e,0x28,0x55,0x69,0x6e,0x74,0x33,0x32,0x41,0x72,0x72,
-0x61,0x79,0x2c,0x21,0x31,0x29,0x2c,0x37,0x32,0x3a,0x65,0x3d,0x3e,0x6e,0x65,0x77,
-0x20,0x49,0x6e,0x74,0x38,0x41,0x72,0x72,0x61,0x79,0x28,0x65,0x2e,0x62,0x75,0x66,
-0x66,0x65,0x72,0x2c,0x65,0x2e,0x62,0x79,0x74,0x65,0x4f,0x66,0x66,0x73,0x65,0x74,
-0x2c,0x65,0x2e,0x6c,0x65,0x6e,0x67,0x74,0x68,0x29,0x2c,0x37,0x33,0x3a,0x6e,0x28,
-0x49,0x6e,0x74,0x31,0x36,0x41,0x72,0x72,0x61,0x79,0x2c,0x21,0x30,0x29,0x2c,0x37,
-0x34,0x3a,0x6e,0x28,0x49,0x6e,0x74,0x33,0x32,0x41,0x72,0x72,0x61,0x79,0x2c,0x21,
-0x30,0x29,0x2c,0x37,0x37,0x3a,0x6e,0x28,0x49,0x6e,0x74,0x31,0x36,0x41,0x72,0x72,
-0x61,0x79,0x2c,0x21,0x31,0x29,0x2c,0x37,0x38,0x3a,0x6e,0x28,0x49,0x6e,0x74,0x33,
-0x32,0x41,0x72,0x72,0x61,0x79,0x2c,0x21,0x31,0x29,0x2c,0x38,0x30,0x3a,0x72,0x26,
-0x26,0x6e,0x28,0x46,0x6c,0x6f,0x61,0x74,0x31,0x36,0x41,0x72,0x72,0x61,0x79,0x2c,
-0x21,0x30,0x29,0x2c,0x38,0x31,0x3a,0x6e,0x28,0x46,0x6c,0x6f,0x61,0x74,0x33,0x32,
-0x41,0x72,0x72,0x61,0x79,0x2c,0x21,0x30,0x29,0x2c,0x38,0x32,0x3a,0x6e,0x28,0x46,
-0x6c,0x6f,0x61,0x74,0x36,0x34,0x41,0x72,0x72,0x61,0x79,0x2c,0x21,0x30,0x29,0x2c,
-0x38,0x34,0x3a,0x72,0x26,0x26,0x6e,0x28,0x46,0x6c,0x6f,0x61,0x74,0x31,0x36,0x41,
-0x72,0x72,0x61,0x79,0x2c,0x21,0x31,0x29,0x2c,0x38,0x35,0x3a,0x6e,0x28,0x46,0x6c,
-0x6f,0x61,0x74,0x33,0x32,0x41,0x72,0x72,0x61,0x79,0x2c,0x21,0x31,0x29,0x2c,0x38,
-0x36,0x3a,0x6e,0x28,0x46,0x6c,0x6f,0x61,0x74,0x36,0x34,0x41,0x72,0x72,0x61,0x79,
-0x2c,0x21,0x31,0x29,0x7d,0x29,0x2c,0x22,0x66,0x75,0x6e,0x63,0x74,0x69,0x6f,0x6e,
-0x22,0x3d,0x3d,0x74,0x79,0x70,0x65,0x6f,0x66,0x20,0x42,0x69,0x67,0x55,0x69,0x6e,
-0x74,0x36,0x34,0x41,0x72,0x72,0x61,0x79,0x26,0x26,0x22,0x66,0x75,0x6e,0x63,0x74,
-0x69,0x6f,0x6e,0x22,0x3d,0x3d,0x74,0x79,0x70,0x65,0x6f,0x66,0x20,0x42,0x69,0x67,
-0x49,0x6e,0x74,0x36,0x34,0x41,0x72,0x72,0x61,0x79,0x26,0x26,0x28,0x42,0x69,0x67,
-0x55,0x69,0x6e,0x74,0x36,0x34,0x41,0x72,0x72,0x61,0x79,0x2e,0x70,0x72,0x6f,0x74,
-0x6f,0x74,0x79,0x70,0x65,0x5b,0x65,0x5d,0x3d,0x65,0x3d,0x3e,0x5b,0x73,0x3f,0x36,
-0x37,0x3a,0x37,0x31,0x2c,0x74,0x28,0x65,0x29,0x5d,0x2c,0x42,0x69,0x67,0x49,0x6e,
-0x74,0x36,0x34,0x41,0x72,0x72,0x61,0x79,0x2e,0x70,0x72,0x6f,0x74,0x6f,0x74,0x79,
-0x70,0x65,0x5b,0x65,0x5d,0x3d,0x65,0x3d,0x3e,0x5b,0x73,0x3f,0x37,0x35,0x3a,0x37,
-0x39,0x2c,0x74,0x28,0x65,0x29,0x5d,0x2c,0x4f,0x62,0x6a,0x65,0x63,0x74,0x2e,0x61,
-0x73,0x73,0x69,0x67,0x6e,0x28,0x43,0x42,0x4f,0x52,0x2e,0x64,0x65,0x63,0x6f,0x64,
-0x65,0x54,0x61,0x67,0x73,0x2c,0x7b,0x36,0x37,0x3a,0x6e,0x28,0x42,0x69,0x67,0x55,
-0x69,0x6e,0x74,0x36,0x34,0x41,0x72,0x72,0x61,0x79,0x2c,0x21,0x30,0x29,0x2c,0x37,
-0x31,0x3a,0x6e,0x28,0x42,0x69,0x67,0x55,0x69,0x6e,0x74,0x36,0x34,0x41,0x72,0x72,
-0x61,0x79,0x2c,0x21,0x31,0x29,0x2c,0x37,0x35,0x3a,0x6e,0x28,0x42,0x69,0x67,0x49,
-0x6e,0x74,0x36,0x34,0x41,0x72,0x72,0x61,0x79,0x2c,0x21,0x30,0x29,0x2c,0x37,0x39,
-0x3a,0x6e,0x28,0x42,0x69,0x67,0x49,0x6e,0x74,0x36,0x34,0x41,0x72,0x72,0x61,0x79,
-0x2c,0x21,0x31,0x29,0x7d,0x29,0x29,0x7d,0x29,0x28,0x43,0x42,0x4f,0x52,0x2e,0x65,
-0x6e,0x63,0x6f,0x64,0x65,0x54,0x61,0x67,0x2c,0x21,0x21,0x6e,0x65,0x77,0x20,0x55,
-0x69,0x6e,0x74,0x38,0x41,0x72,0x72,0x61,0x79,0x28,0x6e,0x65,0x77,0x20,0x55,0x69,
-0x6e,0x74,0x31,0x36,0x41,0x72,0x72,0x61,0x79,0x28,0x5b,0x32,0x35,0x36,0x5d,0x29,
-0x2e,0x62,0x75,0x66,0x66,0x65,0x72,0x29,0x5b,0x30,0x5d,0x29,0x2c,0x22,0x6f,0x62,
-0x6a,0x65,0x63,0x74,0x22,0x3d,0x3d,0x74,0x79,0x70,0x65,0x6f,0x66,0x20,0x6d,0x6f,
-0x64,0x75,0x6c,0x65,0x26,0x26,0x6d,0x6f,0x64,0x75,0x6c,0x65,0x3f,0x2e,0x65,0x78,
-0x70,0x6f,0x72,0x74,0x73,0x26,0x26,0x28,0x6d,0x6f,0x64,0x75,0x6c,0x65,0x2e,0x65,
-0x78,0x70,0x6f,0x72,0x74,0x73,0x3d,0x43,0x42,0x4f,0x52,0x29,0x3b,0x0a,
-};
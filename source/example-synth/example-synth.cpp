@@ -1,37 +1,76 @@
 #ifndef LOG_EXPR
-#	include <iostream>
-#	define LOG_EXPR(expr) std::cout << #expr " = " << (expr) << std::endl;
+#	include "signalsmith-clap/log.h"
+#	define LOG_EXPR(expr) SIGNALSMITH_CLAP_LOG_EXPR(expr)
 #endif
 
 #include "example-synth.h"
 
 clap_process_status ExampleSynth::pluginProcess(const clap_process *process) {
+	// We declare `CLAP_AUDIO_PORT_SUPPORTS_64BITS`, so the host can give us either (but the same for every port)
+	if (process->audio_outputs_count && process->audio_outputs[0].data64) return processSamples<double>(process);
+	return processSamples<float>(process);
+}
+
+template<class Sample>
+clap_process_status ExampleSynth::processSamples(const clap_process *process) {
+	using signalsmith::clap::bufferChannels;
+	bool inputSilent = true;
+	for (uint32_t inPort = 0; inPort < process->audio_inputs_count; ++inPort) {
+		inputSilent = inputSilent && signalsmith::clap::isSilent(process->audio_inputs[inPort], process->frames_count);
+	}
+	// No voices, no events and no input: just silence, and the host can stop calling us until something changes
+	auto *eventsIn = process->in_events;
+	uint32_t eventCount = eventsIn->size(eventsIn);
+	if (inputSilent && !eventCount && noteManager.activeNotes().empty()) {
+		for (uint32_t outPort = 0; outPort < process->audio_outputs_count; ++outPort) {
+			signalsmith::clap::writeSilence(process->audio_outputs[outPort], process->frames_count);
+		}
+		perfStats.updateVoices(noteManager);
+		if (signalsmith::clap::Trace::instance().needsDrain()) host->request_callback(host);
+		return CLAP_PROCESS_SLEEP;
+	}
+
 	for (uint32_t outPort = 0; outPort < process->audio_outputs_count; ++outPort) {
 		auto &outBuffer = process->audio_outputs[outPort];
+		outBuffer.constant_mask = 0;
+		Sample **outputs = bufferChannels<Sample>(outBuffer);
 		if (outPort < process->audio_inputs_count) {
 			auto &inBuffer = process->audio_inputs[outPort];
-			// Copy input
+			Sample **inputs = bufferChannels<Sample>(inBuffer);
+			// Copy input (and which channels are constant, which stays true unless a voice adds to it)
 			for (uint32_t outC = 0; outC < outBuffer.channel_count; ++outC) {
 				uint32_t inC = outC%(inBuffer.channel_count);
-				if (outBuffer.data32 && inBuffer.data32) {
-					memcpy(outBuffer.data32[outC], inBuffer.data32[inC], process->frames_count*4);
+				// Nothing to do if the host gave us the same buffer (see `in_place_pair`)
+				if (outputs && inputs && outputs[outC] != inputs[inC]) {
+					memmove(outputs[outC], inputs[inC], process->frames_count*sizeof(Sample));
+				}
+				if (outC < 64 && inC < 64 && (inBuffer.constant_mask&(uint64_t(1)<<inC))) {
+					outBuffer.constant_mask |= uint64_t(1)<<outC;
 				}
 			}
 		} else {
 			// Zero
 			for (uint32_t outC = 0; outC < outBuffer.channel_count; ++outC) {
-				if (outBuffer.data32) {
-					memset(outBuffer.data32[outC], 0, process->frames_count*4);
+				if (outputs) {
+					memset(outputs[outC], 0, process->frames_count*sizeof(Sample));
 				}
 			}
+			outBuffer.constant_mask = signalsmith::clap::allChannelsMask(outBuffer.channel_count);
 		}
 	}
 
+	// Counts any events the host doesn't accept
+	signalsmith::clap::CountingOutputEvents countingEventsOut{process->out_events, perfStats.droppedEvents};
+	auto *eventsOut = &countingEventsOut;
+
 	auto &synthOut = process->audio_outputs[0];
+	Sample **synthOutputs = bufferChannels<Sample>(synthOut);
 	float sustainAmp = std::pow(10, sustainDb.value/20);
+	bool voicesWritten = false;
 
 	noteManager.startBlock();
 	auto processNoteTask = [&](auto &note) {
+		signalsmith::clap::TraceSpan span{"noteTask"};
 		auto &osc = oscillators[note.voiceIndex];
 
 		auto hz = 440*std::exp2((note.key - 69)/12);
@@ -70,6 +109,7 @@ clap_process_status ExampleSynth::pluginProcess(const clap_process *process) {
 			targetAr = 0;
 		}
 		
+		voicesWritten = voicesWritten || (processTo > note.processFrom);
 		for (uint32_t i = note.processFrom; i < processTo; ++i) {
 			osc.attackRelease += (targetAr - osc.attackRelease)*arSlew;
 			osc.decay += (sustainAmp - osc.decay)*decaySlew;
@@ -78,27 +118,24 @@ clap_process_status ExampleSynth::pluginProcess(const clap_process *process) {
 			auto amp = osc.attackRelease*osc.decay;
 			auto v = amp*std::sin(float(2*M_PI)*osc.phase);
 			// stereo out
-			synthOut.data32[0][i] += v;
-			synthOut.data32[1][i] += v;
+			synthOutputs[0][i] += v;
+			synthOutputs[1][i] += v;
 		}
 		osc.phase -= std::floor(osc.phase);
 
 		if (note.released() && osc.canStop()) {
-			noteManager.stop(note, process->out_events);
+			noteManager.stop(note, eventsOut);
 		}
 	};
-	auto processNoteTasks = [&](auto tasks) {
+	auto processNoteTasks = [&](const auto &tasks) {
 		for (auto &task : tasks) processNoteTask(task);
 	};
 
-	auto *eventsIn = process->in_events;
-	auto *eventsOut = process->out_events;
-	uint32_t eventCount = eventsIn->size(eventsIn);
 	for (uint32_t i = 0; i < eventCount; ++i) {
 		auto *event = eventsIn->get(eventsIn, i);
 		if (auto newNote = noteManager.wouldStart(event)) {
 			bool foundLegato = false;
-			if (polyphony.value == 0) {
+			if (!isPolyphonic()) {
 				for (auto &otherNote : noteManager) {
 					if (otherNote.channel != newNote->channel || otherNote.port != newNote->port) continue;
 					if (otherNote.released() && otherNote.ageAt(event->time) > sampleRate*0.01f) continue;
@@ -122,6 +159,11 @@ clap_process_status ExampleSynth::pluginProcess(const clap_process *process) {
 	}
 	
 	processNoteTasks(noteManager.processTo(process->frames_count));
+	perfStats.updateVoices(noteManager);
+	if (voicesWritten && process->audio_outputs_count) synthOut.constant_mask = 0;
 	
-	return CLAP_PROCESS_CONTINUE;
+	if (signalsmith::clap::Trace::instance().needsDrain()) host->request_callback(host);
+	if (!noteManager.activeNotes().empty()) return CLAP_PROCESS_CONTINUE;
+	// Without any voices, we're just passing the input through
+	return inputSilent ? CLAP_PROCESS_SLEEP : CLAP_PROCESS_CONTINUE_IF_NOT_QUIET;
 }
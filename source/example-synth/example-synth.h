@@ -1,7 +1,14 @@
 #include "clap/clap.h"
 
 #include "signalsmith-clap/cpp.h"
+#include "signalsmith-clap/id-table.h"
+#include "signalsmith-clap/instrument.h"
 #include "signalsmith-clap/note-manager.h"
+#include "signalsmith-clap/params.h"
+#include "signalsmith-clap/perf-stats.h"
+#include "signalsmith-clap/param-state.h"
+#include "signalsmith-clap/silence.h"
+#include "signalsmith-clap/trace.h"
 
 #include "../plugins.h"
 
@@ -56,31 +63,48 @@ struct ExampleSynth {
 	using NoteManager = signalsmith::clap::NoteManager;
 	NoteManager noteManager{512};
 	
-	struct {
-		clap_id id = 0xCA55E77E;
-		double value = -20;
-	} sustainDb;
-	struct {
-		clap_id id = 0xCA5CADE5;
-		int value = 1;
-	} polyphony;
+	using Param = signalsmith::clap::Param;
+	Param sustainDb{"sustain", "sustain", 0xCA55E77E, -40, -20, 0};
+	Param polyphony{"polyphony", "polyphony", 0xCA5CADE5, 0, 1, 1};
+	signalsmith::clap::ParamRegistry params{&sustainDb, &polyphony};
 
 	ExampleSynth(const clap_host *host) : host(host) {
 		oscillators.resize(noteManager.polyphony());
 		noteManager.pitchWheelRange = 48; // MPE
+
+		sustainDb.formatFn = [](double value){
+			return std::to_string(int(std::round(value))) + " dB";
+		};
+		polyphony.info.flags |= CLAP_PARAM_IS_STEPPED;
+		polyphony.formatFn = [](double value){
+			return std::string(std::round(value) == 0 ? "monophonic" : "polyphonic");
+		};
+	}
+	
+	bool isPolyphonic() const {
+		return std::round(polyphony.value) != 0;
 	}
 
-	// Makes a C function pointer to a C++ method
+	signalsmith::clap::PerfStats perfStats;
+#ifdef SIGNALSMITH_CLAP_INSTRUMENT
+	signalsmith::clap::Instrumentation instrumentation;
+#endif
+
+	// Makes a C function pointer to a C++ method (timing each call, checking `process()` for allocations, or capturing its events, if enabled)
 	template<auto methodPtr>
-	auto clapPluginMethod() -> decltype(signalsmith::clap::pluginMethod<methodPtr>()) {
+	static constexpr auto clapPluginMethod() -> decltype(signalsmith::clap::pluginMethod<methodPtr>()) {
+#if defined(SIGNALSMITH_CLAP_INSTRUMENT) || defined(SIGNALSMITH_CLAP_RT_GUARD) || defined(SIGNALSMITH_CLAP_CAPTURE)
+		return signalsmith::clap::instrumentedPluginMethod<methodPtr>();
+#else
 		return signalsmith::clap::pluginMethod<methodPtr>();
+#endif
 	}
 
 	const clap_plugin clapPlugin{
 		.desc=getPluginDescriptor(),
 		.plugin_data=this,
 		.init=clapPluginMethod<&ExampleSynth::pluginInit>(),
-		.destroy=clapPluginMethod<&ExampleSynth::pluginDestroy>(),
+		.destroy=signalsmith::clap::pluginDestroyMethod<&ExampleSynth::pluginDestroy>(), // not timed, since it deletes the instance
 		.activate=clapPluginMethod<&ExampleSynth::pluginActivate>(),
 		.deactivate=clapPluginMethod<&ExampleSynth::pluginDeactivate>(),
 		.start_processing=clapPluginMethod<&ExampleSynth::pluginStartProcessing>(),
@@ -117,13 +141,12 @@ struct ExampleSynth {
 		noteManager.reset();
 	}
 	void processEvent(const clap_event_header *event) {
+		signalsmith::clap::TraceSpan span{"processEvent"};
 		if (event->space_id != CLAP_CORE_EVENT_SPACE_ID) return;
 		if (event->type == CLAP_EVENT_PARAM_VALUE) {
 			auto &eventParam = *(const clap_event_param_value *)event;
-			if (eventParam.param_id == sustainDb.id) {
-				sustainDb.value = eventParam.value;
-			} else if (eventParam.param_id == polyphony.id) {
-				polyphony.value = int(std::round(eventParam.value));
+			if (auto *param = params.find(eventParam)) {
+				param->setValueFromEvent(eventParam);
 			}
 
 			// Request a callback so we can tell the host our state is dirty
@@ -132,6 +155,8 @@ struct ExampleSynth {
 		}
 	}
 	clap_process_status pluginProcess(const clap_process *process);
+	template<class Sample>
+	clap_process_status processSamples(const clap_process *process);
 
 	bool stateDirty = false;
 	void pluginOnMainThread() {
@@ -139,51 +164,50 @@ struct ExampleSynth {
 			hostState->mark_dirty(host);
 			stateDirty = false;
 		}
+		signalsmith::clap::Trace::instance().drain();
 	}
 
 	const void * pluginGetExtension(const char *extId) {
-		if (!std::strcmp(extId, CLAP_EXT_STATE)) {
-			static const clap_plugin_state ext{
-				.save=clapPluginMethod<&ExampleSynth::stateSave>(),
-				.load=clapPluginMethod<&ExampleSynth::stateLoad>(),
-			};
-			return &ext;
-		} else if (!std::strcmp(extId, CLAP_EXT_AUDIO_PORTS)) {
-			static const clap_plugin_audio_ports ext{
-				.count=clapPluginMethod<&ExampleSynth::audioPortsCount>(),
-				.get=clapPluginMethod<&ExampleSynth::audioPortsGet>(),
-			};
-			return &ext;
-		} else if (!std::strcmp(extId, CLAP_EXT_NOTE_PORTS)) {
-			static const clap_plugin_note_ports ext{
-				.count=clapPluginMethod<&ExampleSynth::notePortsCount>(),
-				.get=clapPluginMethod<&ExampleSynth::notePortsGet>(),
-			};
-			return &ext;
-		} else if (!std::strcmp(extId, CLAP_EXT_PARAMS)) {
-			static const clap_plugin_params ext{
-				.count=clapPluginMethod<&ExampleSynth::paramsCount>(),
-				.get_info=clapPluginMethod<&ExampleSynth::paramsGetInfo>(),
-				.get_value=clapPluginMethod<&ExampleSynth::paramsGetValue>(),
-				.value_to_text=clapPluginMethod<&ExampleSynth::paramsValueToText>(),
-				.text_to_value=clapPluginMethod<&ExampleSynth::paramsTextToValue>(),
-				.flush=clapPluginMethod<&ExampleSynth::paramsFlush>(),
-			};
-			return &ext;
-		}
-		return nullptr;
+		static const clap_plugin_state stateExt{
+			.save=clapPluginMethod<&ExampleSynth::stateSave>(),
+			.load=clapPluginMethod<&ExampleSynth::stateLoad>(),
+		};
+		static const clap_plugin_audio_ports audioPortsExt{
+			.count=clapPluginMethod<&ExampleSynth::audioPortsCount>(),
+			.get=clapPluginMethod<&ExampleSynth::audioPortsGet>(),
+		};
+		static const clap_plugin_note_ports notePortsExt{
+			.count=clapPluginMethod<&ExampleSynth::notePortsCount>(),
+			.get=clapPluginMethod<&ExampleSynth::notePortsGet>(),
+		};
+		static const auto extensions = signalsmith::clap::makeIdTable<const void *>({
+			{CLAP_EXT_STATE, &stateExt},
+			{CLAP_EXT_AUDIO_PORTS, &audioPortsExt},
+			{CLAP_EXT_NOTE_PORTS, &notePortsExt},
+			{CLAP_EXT_PARAMS, signalsmith::clap::ParamRegistry::extension<&ExampleSynth::params, &ExampleSynth::paramsFlush>()},
+			{signalsmith::clap::CLAP_EXT_PERF_STATS, signalsmith::clap::PerfStats::extension<&ExampleSynth::perfStats>()}
+		});
+		return extensions.find(extId);
 	}
 	
 	// ---- state save/load ----
 	
+	// Change this if parameters are added/removed/reordered
+	static constexpr uint32_t stateLayoutVersion = 1;
+
 	bool stateSave(const clap_ostream_t *stream) {
-		// very basic string serialisation
-		std::string stateString = (polyphony.value ? "P" : "M") + std::to_string(sustainDb.value);
-		return signalsmith::clap::writeAllToStream(stateString, stream);
+		return signalsmith::clap::saveParamState(params, stateLayoutVersion, stream);
 	}
 	bool stateLoad(const clap_istream_t *stream) {
+		using Result = signalsmith::clap::ParamStateResult;
 		std::string stateString;
-		if (!signalsmith::clap::readAllFromStream(stateString, stream) || stateString.empty()) return false;
+		auto result = signalsmith::clap::loadParamState(params, stateLayoutVersion, stream, stateString);
+		if (result == Result::otherFormat) return stateLoadString(stateString);
+		return result != Result::error;
+	}
+	// Older versions used a very basic string serialisation
+	bool stateLoadString(const std::string &stateString) {
+		if (stateString.empty()) return false;
 		polyphony.value = (stateString[0] == 'P' ? 1 : 0);
 		auto value = strtod(stateString.c_str() + 1, nullptr);
 		if (value >= -40 && value <= 0) {
@@ -203,10 +227,10 @@ struct ExampleSynth {
 		*info = {
 			.id=0xF0CACC1A,
 			.name={'m', 'a', 'i', 'n'},
-			.flags=CLAP_AUDIO_PORT_IS_MAIN + CLAP_AUDIO_PORT_REQUIRES_COMMON_SAMPLE_SIZE,
+			.flags=CLAP_AUDIO_PORT_IS_MAIN + CLAP_AUDIO_PORT_SUPPORTS_64BITS + CLAP_AUDIO_PORT_REQUIRES_COMMON_SAMPLE_SIZE,
 			.channel_count=2,
 			.port_type=CLAP_PORT_STEREO,
-			.in_place_pair=CLAP_INVALID_ID
+			.in_place_pair=0xF0CACC1A // input and output have the same ID
 		};
 		return true;
 	}
@@ -229,73 +253,6 @@ struct ExampleSynth {
 
 	// ---- parameters ----
 	
-	uint32_t paramsCount() {
-		return 2;
-	}
-	
-	bool paramsGetInfo(uint32_t index, clap_param_info *info) {
-		if (index == 0) {
-			*info = {
-				.id=sustainDb.id,
-				.flags=CLAP_PARAM_IS_AUTOMATABLE,
-				.cookie=nullptr,
-				.name={}, // assigned below
-				.module={},
-				.min_value=-40,
-				.max_value=0,
-				.default_value=-20
-			};
-			std::strncpy(info->name, "sustain", CLAP_NAME_SIZE);
-			return true;
-		} else if (index == 1) {
-			*info = {
-				.id=polyphony.id,
-				.flags=CLAP_PARAM_IS_AUTOMATABLE + CLAP_PARAM_IS_STEPPED,
-				.cookie=nullptr,
-				.name={}, // assigned below
-				.module={},
-				.min_value=0,
-				.max_value=1,
-				.default_value=1
-			};
-			std::strncpy(info->name, "polyphony", CLAP_NAME_SIZE);
-			return true;
-		}
-		return false;
-	}
-	
-	bool paramsGetValue(clap_id paramId, double *value) {
-		if (paramId == sustainDb.id) {
-			*value = sustainDb.value;
-			return true;
-		} else if (paramId == polyphony.id) {
-			*value = double(polyphony.value);
-		}
-		return false;
-	}
-	
-	bool paramsValueToText(clap_id paramId, double value, char *text, uint32_t textCapacity) {
-		if (paramId == sustainDb.id) {
-			std::snprintf(text, textCapacity, "%i dB", int(std::round(value)));
-			return true;
-		} else if (paramId == polyphony.id) {
-			std::strncpy(text, std::round(value) == 0 ? "monophonic" : "polyphonic", textCapacity);
-			return true;
-		}
-		return false;
-	}
-
-	bool paramsTextToValue(clap_id paramId, const char *text, double *value) {
-		if (paramId == sustainDb.id) {
-			char *numberEnd;
-			*value = std::strtod(text, &numberEnd);
-			if (!(*value >= 50)) *value = 50;
-			if (!(*value <= 500)) *value = 500;
-			return (numberEnd != text);
-		}
-		return false;
-	}
-	
 	void paramsFlush(const clap_input_events *eventsIn, const clap_output_events *eventsOut) {
 		uint32_t eventCount = eventsIn->size(eventsIn);
 		for (uint32_t i = 0; i < eventCount; ++i) {
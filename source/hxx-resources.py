@@ -1,28 +1,166 @@
 #!/usr/bin/env python3
 
+# Embeds each plugin's `resources/` directory, as `embedded-resources.hxx` (plus `embedded-resources.S` in `incbin` mode)
+# and/or writes them all into a single resource pack (see `include/signalsmith-clap/resource-pack.h`)
+# Identical files (e.g. `cbor.min.js`) are only stored once.
+#
+# This is run by CMake whenever a resource changes (the `.hxx` is only rewritten if it actually changes), with one of these modes:
+#	incbin: the assembler pulls in the files directly (GCC/Clang for ELF or Mach-O targets)
+#	embed: C23-style `#embed`, for compilers which support it in C++
+#	array: plain C++ arrays, which works everywhere but is slowest to compile
+#	none: don't embed anything (just write the `--pack`)
+
+import argparse
 import glob
+import hashlib
 import os.path
-import binascii
+import struct
+
+sourceDir = os.path.dirname(os.path.abspath(__file__))
+
+parser = argparse.ArgumentParser()
+parser.add_argument("--output", help="directory for the generated files")
+parser.add_argument("--mode", default="array", choices=["incbin", "embed", "array", "none"])
+parser.add_argument("--pack", help="resource pack file to write")
+args = parser.parse_args()
+if args.mode != "none" and not args.output:
+	parser.error("--output is required unless --mode=none")
+
+mediaTypes = {
+	".html": "text/html",
+	".js": "application/javascript",
+	".css": "text/css",
+	".json": "application/json",
+	".svg": "image/svg+xml",
+	".png": "image/png",
+	".wasm": "application/wasm",
+}
+
+def identifier(name):
+	return "".join(c if c.isalnum() else "_" for c in name)
 
-globPattern = os.path.dirname(__file__) + "/**/resources/*";
+def cArray(data):
+	lines = []
+	for i in range(0, len(data), 32):
+		lines.append(",".join(str(b) for b in data[i:i + 32]) + ",")
+	return "\n".join(lines)
 
-for path in glob.glob(globPattern, recursive=True):
-	if path.endswith(".hxx"):
+def cString(text):
+	return '"' + text.replace("\\", "\\\\").replace('"', '\\"') + '"'
+
+# Blob names come from the first file with that content (not the content itself), so in `incbin` mode the `.hxx` only changes when files are added/removed/deduplicated, and editing a resource just re-assembles the `.S`
+blobs = {} # hash -> (name, path, bytes)
+tables = {} # table name -> [(path, mediaType, blob name)]
+packEntries = [] # (path, mediaType, hash)
+
+for path in sorted(glob.glob(sourceDir + "/*/resources/**/*", recursive=True)):
+	if not os.path.isfile(path) or path.endswith(".hxx"):
 		continue
-	var = os.path.basename(path).replace(".", "_")
-	print(path)
-	print(var)
+	path = os.path.abspath(path).replace(os.sep, "/")
+	resourceDir = path[:path.index("/resources/") + len("/resources/")]
+	pluginDir = os.path.basename(os.path.dirname(os.path.dirname(resourceDir)))
+	table = identifier(pluginDir)
+	relPath = os.path.relpath(path, resourceDir).replace(os.sep, "/")
 	with open(path, 'rb') as file:
-		with open(path + ".hxx", 'w') as hxx:
-			hxx.write("const unsigned char " + var + "[] = {")
-			byteCounter = 0;
-			byte = file.read(1)
-			while byte:
-				if byteCounter%1024 == 0:
-					hxx.write("\n// %i"%byteCounter)
-				if byteCounter%16 == 0:
-					hxx.write("\n");
-				byteCounter += 1;
-				hxx.write("0x" + binascii.b2a_hex(byte).decode('utf8') + ",")
-				byte = file.read(1)
-			hxx.write("\n};\n")
+		data = file.read()
+	digest = hashlib.sha1(data).hexdigest()
+	if digest not in blobs:
+		blobs[digest] = ("blob_" + table + "_" + identifier(relPath), path, data)
+	mediaType = mediaTypes.get(os.path.splitext(path)[1], "application/octet-stream")
+	tables.setdefault(table, []).append((relPath, mediaType, blobs[digest][0]))
+	packEntries.append((pluginDir + "/" + relPath, mediaType, digest))
+
+def writePack(filename):
+	# Must match `ResourcePackHeader`/`ResourcePackEntry`
+	headerFormat, entryFormat = "<IIII", "<IIQQ"
+	entryOffset = struct.calcsize(headerFormat)
+	stringOffset = entryOffset + len(packEntries)*struct.calcsize(entryFormat)
+
+	strings = bytearray()
+	stringOffsets = {}
+	def addString(text):
+		if text not in stringOffsets:
+			stringOffsets[text] = stringOffset + len(strings)
+			strings.extend(text.encode('utf-8') + b"\0")
+		return stringOffsets[text]
+	entryStrings = [(addString(path), addString(mediaType)) for (path, mediaType, digest) in packEntries]
+
+	data = bytearray()
+	dataStart = (stringOffset + len(strings) + 15)//16*16
+	dataOffsets = {}
+	for (path, mediaType, digest) in packEntries:
+		if digest not in dataOffsets:
+			data.extend(b"\0"*(-len(data)%16))
+			dataOffsets[digest] = dataStart + len(data)
+			data.extend(blobs[digest][2])
+
+	pack = bytearray(struct.pack(headerFormat, 0x50525353, 1, len(packEntries), entryOffset))
+	for ((path, mediaType, digest), (pathOffset, mediaTypeOffset)) in zip(packEntries, entryStrings):
+		pack.extend(struct.pack(entryFormat, pathOffset, mediaTypeOffset, dataOffsets[digest], len(blobs[digest][2])))
+	pack.extend(strings)
+	pack.extend(b"\0"*(dataStart - len(pack)))
+	pack.extend(data)
+
+	os.makedirs(os.path.dirname(os.path.abspath(filename)), exist_ok=True)
+	with open(filename, 'wb') as file:
+		file.write(pack)
+
+if args.pack:
+	writePack(args.pack)
+
+def writeIfChanged(filename, text):
+	outputPath = os.path.join(args.output, filename)
+	if os.path.exists(outputPath):
+		with open(outputPath, 'r') as file:
+			if file.read() == text:
+				return
+	with open(outputPath, 'w') as file:
+		file.write(text)
+
+if args.mode == "none":
+	exit(0)
+
+os.makedirs(args.output, exist_ok=True)
+
+hxx = "// Generated by `hxx-resources.py` - do not edit\n"
+hxx += "#pragma once\n\n#include \"signalsmith-clap/embedded-resources.h\"\n\n"
+if args.mode == "incbin":
+	hxx += "extern \"C\" {\n"
+	for (name, path, data) in blobs.values():
+		hxx += "\textern const unsigned char %s[];\n\textern const unsigned long long %s_size;\n" % (name, name)
+	hxx += "}\n\n"
+hxx += "namespace embedded_resources {\n\n"
+if args.mode == "embed":
+	for (name, path, data) in blobs.values():
+		hxx += "inline constexpr unsigned char %s[] = {\n#embed %s\n};\n\n" % (name, cString(path))
+elif args.mode == "array":
+	for (name, path, data) in blobs.values():
+		hxx += "inline constexpr unsigned char %s[] = {\n%s\n};\n\n" % (name, cArray(data))
+for (table, entries) in sorted(tables.items()):
+	if args.mode == "incbin":
+		# The sizes come from the assembly, so aren't compile-time constants
+		hxx += "inline const signalsmith::clap::EmbeddedResource %s[] = {\n" % table
+		for (relPath, mediaType, blob) in entries:
+			hxx += "\t{%s, %s, ::%s, size_t(::%s_size)},\n" % (cString(relPath), cString(mediaType), blob, blob)
+	else:
+		hxx += "inline constexpr signalsmith::clap::EmbeddedResource %s[] = {\n" % table
+		for (relPath, mediaType, blob) in entries:
+			hxx += "\t{%s, %s, %s, sizeof(%s)},\n" % (cString(relPath), cString(mediaType), blob, blob)
+	hxx += "};\n\n"
+hxx += "} // namespace\n"
+writeIfChanged("embedded-resources.hxx", hxx)
+
+if args.mode == "incbin":
+	asm = "// Generated by `hxx-resources.py` - do not edit\n\n"
+	asm += "#if defined(__APPLE__)\n#\tdefine SYMBOL(name) _##name\n#\tdefine HIDDEN .private_extern\n\t.section __TEXT,__const\n"
+	asm += "#else\n#\tdefine SYMBOL(name) name\n#\tdefine HIDDEN .hidden\n\t.section .rodata\n#endif\n\n"
+	for (name, path, data) in blobs.values():
+		asm += "\t.globl SYMBOL(%s)\n\tHIDDEN SYMBOL(%s)\n\t.balign 16\nSYMBOL(%s):\n\t.incbin %s\n1:\n" % (name, name, name, cString(path))
+		asm += "\t.globl SYMBOL(%s_size)\n\tHIDDEN SYMBOL(%s_size)\n\t.balign 8\nSYMBOL(%s_size):\n\t.quad 1b - SYMBOL(%s)\n\n" % (name, name, name, name)
+	asm += "#if defined(__ELF__)\n\t.section .note.GNU-stack,\"\",%progbits\n#endif\n"
+	# Always rewritten, so it gets re-assembled when any of the `.incbin` files change
+	with open(os.path.join(args.output, "embedded-resources.S"), 'w') as file:
+		file.write(asm)
+
+with open(os.path.join(args.output, "embedded-resources.stamp"), 'w') as file:
+	file.write("")
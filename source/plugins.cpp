@@ -1,11 +1,19 @@
+#ifdef SIGNALSMITH_CLAP_RT_GUARD
+// The allocation/lock hooks live here - before anything else includes `rt-guard.h`
+#	define SIGNALSMITH_CLAP_RT_GUARD_IMPLEMENTATION
+#	include "signalsmith-clap/rt-guard.h"
+#endif
+
 #ifndef LOG_EXPR
-#	include <iostream>
-#	define LOG_EXPR(expr) std::cout << #expr " = " << (expr) << std::endl;
+#	include "signalsmith-clap/log.h"
+#	define LOG_EXPR(expr) SIGNALSMITH_CLAP_LOG_EXPR(expr)
 #endif
 
 #include "plugins.h"
 
 #include "clap/clap.h"
+#include "signalsmith-clap/plugin-list.h"
+#include "signalsmith-clap/trace.h"
 
 #include "./example-audio-plugin/example-audio-plugin.h"
 #include "./example-note-plugin/example-note-plugin.h"
@@ -15,54 +23,64 @@
 #include <cstring>
 
 std::string clapBundleResourceDir;
+signalsmith::clap::ResourcePack clapResourcePack;
 
 // ---- Plugin factory ----
 
-static uint32_t pluginFactoryGetPluginCount(const struct clap_plugin_factory *) {
-	return 4;
-}
-static const clap_plugin_descriptor_t * pluginFactoryGetPluginDescriptor(const struct clap_plugin_factory *factory, uint32_t index) {
-	if (index == 0) return ExampleAudioPlugin::getPluginDescriptor();
-	if (index == 1) return ExampleNotePlugin::getPluginDescriptor();
-	if (index == 2) return ExampleKeyboard::getPluginDescriptor();
-	if (index == 3) return ExampleSynth::getPluginDescriptor();
-	return nullptr;
-}
-
-static const clap_plugin_t * pluginFactoryCreatePlugin(const struct clap_plugin_factory *, const clap_host_t *host, const char *pluginId) {
-	if (!std::strcmp(pluginId, ExampleAudioPlugin::getPluginDescriptor()->id)) {
-		return ExampleAudioPlugin::create(host);
-	} else if (!std::strcmp(pluginId, ExampleNotePlugin::getPluginDescriptor()->id)) {
-		return ExampleNotePlugin::create(host);
-	} else if (!std::strcmp(pluginId, ExampleKeyboard::getPluginDescriptor()->id)) {
-		return ExampleKeyboard::create(host);
-	} else if (!std::strcmp(pluginId, ExampleSynth::getPluginDescriptor()->id)) {
-		return ExampleSynth::create(host);
-	}
-	return nullptr;
-}
+// Add new plugins here
+using Plugins = signalsmith::clap::PluginList<
+	ExampleAudioPlugin,
+	ExampleNotePlugin,
+	ExampleKeyboard,
+	ExampleSynth
+>;
 
 // ---- Main bundle methods ----
 
+// In the bundle's resources on Mac, otherwise next to the plugin binary (which is what `path` points to)
+static std::string resourcePackPath(const char *path) {
+#if defined(__APPLE__) && (!defined(TARGET_OS_IPHONE) || !TARGET_OS_IPHONE)
+	return clapBundleResourceDir + "/resources.pack";
+#else
+	std::string dir = path;
+	auto slash = dir.find_last_of("/\\");
+	dir = (slash == std::string::npos) ? "." : dir.substr(0, slash);
+	return dir + "/resources.pack";
+#endif
+}
+
 bool clapEntryInit(const char *path) {
 	clapBundleResourceDir = path;
 #if defined(__APPLE__) && (!defined(TARGET_OS_IPHONE) || !TARGET_OS_IPHONE)
 	clapBundleResourceDir += "/Contents/Resources";
+#endif
+	// If this fails, plugins fall back to their embedded resources (if there are any)
+	clapResourcePack.open(resourcePackPath(path));
+	// e.g. `SIGNALSMITH_CLAP_LOG=stderr` - anything logged (including `LOG_EXPR()`) gets written out from a background thread
+	signalsmith::clap::Log::instance().startFromEnvironment("SIGNALSMITH_CLAP_LOG");
+	// e.g. `SIGNALSMITH_CLAP_TRACE=trace.json` - open it in https://ui.perfetto.dev/
+	signalsmith::clap::Trace::instance().startFromEnvironment("SIGNALSMITH_CLAP_TRACE");
+#ifdef SIGNALSMITH_CLAP_CAPTURE
+	// e.g. `SIGNALSMITH_CLAP_CAPTURE=captures/` - replay them with `clap-bench --replay`
+	signalsmith::clap::EventCapture::instance().startFromEnvironment("SIGNALSMITH_CLAP_CAPTURE");
 #endif
 	return true;
 }
 void clapEntryDeinit() {
+	// Pooled webviews might still need resources, so they go first
+	ExampleAudioPlugin::webviewPool().clear();
+	clapResourcePack.close();
 	clapBundleResourceDir = "";
+#ifdef SIGNALSMITH_CLAP_CAPTURE
+	signalsmith::clap::EventCapture::instance().stop();
+#endif
+	signalsmith::clap::Trace::instance().stop();
+	signalsmith::clap::Log::instance().stop();
 }
 
 const void * clapEntryGetFactory(const char *factoryId) {
 	if (!std::strcmp(factoryId, CLAP_PLUGIN_FACTORY_ID)) {
-		static const clap_plugin_factory clapPluginFactory{
-			.get_plugin_count=pluginFactoryGetPluginCount,
-			.get_plugin_descriptor=pluginFactoryGetPluginDescriptor,
-			.create_plugin=pluginFactoryCreatePlugin
-		};
-		return &clapPluginFactory;
+		return Plugins::factory();
 	}
 	return nullptr;
 }
@@ -1,6 +1,10 @@
 #pragma once
 
+#include "signalsmith-clap/resource-pack.h"
+
 #include <string>
 
 // Filled out by `clap_entry::init()`
 extern std::string clapBundleResourceDir;
+// Opened by `clap_entry::init()`, shared by all plugin instances
+extern signalsmith::clap::ResourcePack clapResourcePack;
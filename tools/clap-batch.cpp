@@ -0,0 +1,354 @@
+/* Offline batch renderer: runs one plugin over many WAV (audio) or MIDI files, with a separate instance for each file, across all cores.
+
+	clap-batch --plugin id [--clap path] [--state saved.state] [--output-dir out] [--threads 0] [--block-size 512] [--sample-rate 48000] [--tail 2] [--list files.txt] input.wav input.mid...
+
+Each input `name.wav`/`name.mid` is rendered to `<output-dir>/name.wav` (or `name-2.wav` etc. if another input already has that name) (32-bit float, the input's length plus `--tail` seconds).  WAV files go into the plugin's main audio input at their own sample-rate.  MIDI files go to its first note port (as MIDI, or as CLAP notes if it doesn't take MIDI) at `--sample-rate`.
+
+Audio is read and written through memory-mapped files, and files are shared out with a work-stealing pool (`--threads 0` means one per core).  The plugin's "main thread" calls (create/init/state/activate/destroy) are serialised, and only the processing runs in parallel.
+
+It prints a JSON summary, and exits with an error if any file failed.
+*/
+#include "./clap-host.h"
+#include "./json-writer.h"
+#include "./midi-file.h"
+#include "./wav-file.h"
+#include "./work-pool.h"
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+struct Options {
+	std::string clapPath, pluginId, statePath, outputDir = ".";
+	std::vector<std::string> inputs;
+	size_t threads = 0;
+	uint32_t blockSize = 512;
+	double sampleRate = 48000, tailSeconds = 2;
+};
+
+static bool readLines(const std::string &path, std::vector<std::string> &lines) {
+	std::FILE *file = std::fopen(path.c_str(), "r");
+	if (!file) return false;
+	std::string line;
+	int c;
+	while ((c = std::fgetc(file)) != EOF) {
+		if (c == '\n' || c == '\r') {
+			if (!line.empty()) lines.push_back(line);
+			line.clear();
+		} else {
+			line += char(c);
+		}
+	}
+	if (!line.empty()) lines.push_back(line);
+	std::fclose(file);
+	return true;
+}
+
+static bool parseArgs(int argc, char **argv, Options &options) {
+	for (int i = 1; i < argc; ++i) {
+		std::string arg = argv[i];
+		if (arg.size() < 2 || arg.substr(0, 2) != "--") {
+			options.inputs.push_back(arg);
+			continue;
+		}
+		if (i + 1 >= argc) {
+			std::fprintf(stderr, "missing value for %s\n", arg.c_str());
+			return false;
+		}
+		std::string value = argv[++i];
+		if (arg == "--clap") {
+			options.clapPath = value;
+		} else if (arg == "--plugin") {
+			options.pluginId = value;
+		} else if (arg == "--state") {
+			options.statePath = value;
+		} else if (arg == "--output-dir") {
+			options.outputDir = value;
+		} else if (arg == "--threads") {
+			options.threads = std::strtoul(value.c_str(), nullptr, 10);
+		} else if (arg == "--block-size") {
+			options.blockSize = uint32_t(std::strtoul(value.c_str(), nullptr, 10));
+		} else if (arg == "--sample-rate") {
+			options.sampleRate = std::strtod(value.c_str(), nullptr);
+		} else if (arg == "--tail") {
+			options.tailSeconds = std::strtod(value.c_str(), nullptr);
+		} else if (arg == "--list") {
+			if (!readLines(value, options.inputs)) {
+				std::fprintf(stderr, "couldn't read %s\n", value.c_str());
+				return false;
+			}
+		} else {
+			std::fprintf(stderr, "unknown option: %s\n", arg.c_str());
+			return false;
+		}
+	}
+	if (options.pluginId.empty()) {
+		std::fprintf(stderr, "--plugin is required\n");
+		return false;
+	}
+	if (!options.blockSize) options.blockSize = 512;
+	return true;
+}
+
+static bool readFile(const std::string &path, std::vector<uint8_t> &bytes) {
+	MappedFile file;
+	if (!file.openRead(path)) return false;
+	bytes.assign(file.data, file.data + file.size);
+	return true;
+}
+
+static bool isMidi(const std::string &path) {
+	auto dot = path.find_last_of('.');
+	if (dot == std::string::npos) return false;
+	std::string ext = path.substr(dot + 1);
+	for (auto &c : ext) c = char(std::tolower((unsigned char)c));
+	return ext == "mid" || ext == "midi" || ext == "smf";
+}
+
+// MIDI channel messages, as CLAP events in whatever dialect the plugin takes
+static void addMidiEvent(HostedPlugin &hosted, uint32_t time, const uint8_t bytes[3]) {
+	if (hosted.noteInputDialects&CLAP_NOTE_DIALECT_MIDI) {
+		hosted.eventsIn.add(clap_event_midi{
+			.header={
+				.size=sizeof(clap_event_midi),
+				.time=time,
+				.space_id=CLAP_CORE_EVENT_SPACE_ID,
+				.type=CLAP_EVENT_MIDI,
+				.flags=0
+			},
+			.port_index=0,
+			.data={bytes[0], bytes[1], bytes[2]}
+		});
+	} else if (hosted.noteInputDialects&CLAP_NOTE_DIALECT_CLAP) {
+		uint8_t type = bytes[0]&0xF0;
+		if (type != 0x80 && type != 0x90) return;
+		bool on = (type == 0x90 && bytes[2] > 0);
+		hosted.eventsIn.add(clap_event_note{
+			.header={
+				.size=sizeof(clap_event_note),
+				.time=time,
+				.space_id=CLAP_CORE_EVENT_SPACE_ID,
+				.type=uint16_t(on ? CLAP_EVENT_NOTE_ON : CLAP_EVENT_NOTE_OFF),
+				.flags=0
+			},
+			.note_id=-1,
+			.port_index=0,
+			.channel=int16_t(bytes[0]&0x0F),
+			.key=int16_t(bytes[1]),
+			.velocity=bytes[2]/127.0
+		});
+	}
+}
+
+struct FileResult {
+	std::string output;
+	bool renamed = false;
+	bool ok = false;
+	std::string error;
+	double audioSeconds = 0, processSeconds = 0;
+};
+
+// `<output-dir>/name.wav` for each input, except that names which are already taken (e.g. `a/x.wav` and `b/x.mid`) get a suffix: `x-2.wav`, `x-3.wav`...
+static void chooseOutputs(const Options &options, std::vector<FileResult> &results) {
+	std::set<std::string> taken; // lower-case, for case-insensitive filesystems
+	auto lower = [](std::string name){
+		for (auto &c : name) c = char(std::tolower((unsigned char)c));
+		return name;
+	};
+	for (size_t i = 0; i < options.inputs.size(); ++i) {
+		auto &input = options.inputs[i];
+		std::string name = input.substr(input.find_last_of("/\\") + 1);
+		name = name.substr(0, name.find_last_of('.'));
+		std::string unique = name;
+		for (size_t n = 2; taken.count(lower(unique)); ++n) unique = name + "-" + std::to_string(n);
+		taken.insert(lower(unique));
+		results[i].output = options.outputDir + "/" + unique + ".wav";
+		results[i].renamed = (unique != name);
+	}
+}
+
+// Plugin lifecycle calls are "main thread" ones, so only one file does them at a time
+static std::mutex mainThreadMutex;
+
+static void renderFile(const clap_plugin_factory *factory, const Options &options, const std::vector<uint8_t> *state, const std::string &input, FileResult &result) {
+	WavIn wav;
+	MidiFile midi;
+	bool midiInput = isMidi(input);
+	double sampleRate = options.sampleRate;
+	uint64_t inputFrames;
+	if (midiInput) {
+		if (!midi.open(input)) {
+			result.error = "couldn't read MIDI file";
+			return;
+		}
+		inputFrames = uint64_t(std::ceil(midi.lengthSeconds*sampleRate));
+	} else {
+		if (!wav.open(input)) {
+			result.error = "couldn't read WAV file";
+			return;
+		}
+		sampleRate = wav.sampleRate;
+		inputFrames = wav.frames;
+	}
+	uint64_t totalFrames = inputFrames + uint64_t(options.tailSeconds*sampleRate);
+
+	std::unique_ptr<HostedPlugin> hosted;
+	auto destroy = [&](){
+		std::lock_guard<std::mutex> guard{mainThreadMutex};
+		hosted.reset();
+	};
+	{
+		std::lock_guard<std::mutex> guard{mainThreadMutex};
+		hosted.reset(new HostedPlugin{factory, options.pluginId.c_str()});
+		if (!*hosted) {
+			result.error = "couldn't create plugin";
+			return;
+		}
+		if (state && !hosted->loadState(state->data(), state->size())) {
+			result.error = "couldn't load state";
+			hosted.reset();
+			return;
+		}
+		if (!hosted->activate(sampleRate, options.blockSize)) {
+			result.error = "couldn't activate plugin";
+			hosted.reset();
+			return;
+		}
+	}
+	if (hosted->audioOutputs.empty()) {
+		result.error = "plugin has no audio output";
+		destroy();
+		return;
+	}
+	auto &outputPort = hosted->audioOutputs[0];
+
+	WavOut out;
+	auto &outPath = result.output;
+	if (!out.create(outPath, uint32_t(outputPort.pointers.size()), uint32_t(sampleRate), totalFrames)) {
+		result.error = "couldn't create " + outPath;
+		destroy();
+		return;
+	}
+
+	size_t midiIndex = 0;
+	auto start = std::chrono::steady_clock::now();
+	for (uint64_t blockStart = 0; blockStart < totalFrames; blockStart += options.blockSize) {
+		uint32_t frames = uint32_t(std::min<uint64_t>(options.blockSize, totalFrames - blockStart));
+
+		for (size_t p = 0; p < hosted->audioInputs.size(); ++p) {
+			auto &port = hosted->audioInputs[p];
+			if (p == 0 && !midiInput) {
+				wav.read(blockStart, frames, port.pointers.data(), uint32_t(port.pointers.size()));
+				// Mono files go to every channel
+				if (wav.channels == 1) {
+					for (size_t c = 1; c < port.channels.size(); ++c) std::copy(port.channels[0].begin(), port.channels[0].begin() + frames, port.channels[c].begin());
+				}
+			} else {
+				for (auto &channel : port.channels) std::fill(channel.begin(), channel.begin() + frames, 0.0f);
+			}
+		}
+		while (midiIndex < midi.events.size()) {
+			auto &event = midi.events[midiIndex];
+			uint64_t time = uint64_t(event.seconds*sampleRate);
+			if (time >= blockStart + frames) break;
+			addMidiEvent(*hosted, uint32_t(time > blockStart ? time - blockStart : 0), event.bytes);
+			++midiIndex;
+		}
+
+		if (hosted->process(frames) == CLAP_PROCESS_ERROR) {
+			result.error = "process() failed";
+			destroy();
+			return;
+		}
+		out.write(blockStart, frames, outputPort.pointers.data());
+		hosted->eventsOut.clear();
+		if (hosted->callbackRequested) {
+			std::lock_guard<std::mutex> guard{mainThreadMutex};
+			hosted->mainThread();
+		}
+	}
+	result.processSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	result.audioSeconds = totalFrames/sampleRate;
+	result.ok = true;
+	out.close();
+	destroy();
+}
+
+int main(int argc, char **argv) {
+	Options options;
+	if (!parseArgs(argc, argv, options)) return 1;
+
+	std::unique_ptr<PluginLibrary> library;
+	if (options.clapPath.empty()) {
+		library.reset(new PluginLibrary());
+	} else {
+		library.reset(new PluginLibrary(options.clapPath));
+	}
+	auto *factory = library->factory();
+	if (!factory) {
+		std::fprintf(stderr, "couldn't load plugins: %s\n", library->error.c_str());
+		return 1;
+	}
+
+	std::vector<uint8_t> state;
+	if (!options.statePath.empty() && !readFile(options.statePath, state)) {
+		std::fprintf(stderr, "couldn't read %s\n", options.statePath.c_str());
+		return 1;
+	}
+
+	size_t threads = options.threads ? options.threads : WorkPool::defaultThreads();
+	std::vector<FileResult> results(options.inputs.size());
+	chooseOutputs(options, results);
+	auto start = std::chrono::steady_clock::now();
+	WorkPool::run(options.inputs.size(), threads, [&](size_t index, size_t){
+		renderFile(factory, options, options.statePath.empty() ? nullptr : &state, options.inputs[index], results[index]);
+	});
+	double wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	double audioSeconds = 0, processSeconds = 0;
+	size_t failed = 0;
+	for (auto &result : results) {
+		audioSeconds += result.audioSeconds;
+		processSeconds += result.processSeconds;
+		if (!result.ok) ++failed;
+	}
+	{
+		JsonWriter json{stdout};
+		json.openObject();
+		json.field("plugin", options.pluginId);
+		json.field("threads", (unsigned long long)threads);
+		json.field("files", (unsigned long long)results.size());
+		json.field("failed", (unsigned long long)failed);
+		json.field("audioSeconds", audioSeconds);
+		json.field("wallSeconds", wallSeconds);
+		json.field("processSeconds", processSeconds); // summed across threads
+		json.field("realtimeFactor", audioSeconds/wallSeconds);
+		json.key("renamed").openArray();
+		for (size_t i = 0; i < results.size(); ++i) {
+			if (!results[i].renamed) continue;
+			json.openObject();
+			json.field("input", options.inputs[i]);
+			json.field("output", results[i].output);
+			json.close();
+		}
+		json.close();
+		json.key("failures").openArray();
+		for (size_t i = 0; i < results.size(); ++i) {
+			if (results[i].ok) continue;
+			json.openObject();
+			json.field("input", options.inputs[i]);
+			json.field("error", results[i].error);
+			json.close();
+		}
+	}
+	return failed ? 2 : 0;
+}
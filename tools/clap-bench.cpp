@@ -0,0 +1,319 @@
+/* Headless benchmark: runs each plugin with synthetic audio/events, and reports throughput as JSON.
+
+	clap-bench [--clap path/to/plugins.clap] [--plugin id]... [--sample-rate 44100,48000] [--block-size 64,256] [--sample-bits 32,64] [--in-place 0,1] [--seconds 10] [--notes-per-second 8] [--params-per-second 0] [--output report.json]
+	clap-bench [--clap path/to/plugins.clap] --replay captured.clapevents... [--output report.json]
+
+Without `--clap`, it uses the plugins it was linked against.
+
+`--sample-bits 64` gives plugins 64-bit buffers (if all their ports support it), and `--in-place 1` gives `in_place_pair` ports the same buffer for input and output.  Timings don't include the host converting to/from 64-bit.
+
+With `--replay`, it plays back event streams recorded by `EventCapture` (see `CAPTURE_EVENTS` in `CMakeLists.txt`) instead: the same state (saved on each `activate()`), sample-rate, block sizes, steady time and events, byte-for-byte (except parameter cookies, which are pointers from the original process, so they're swapped for the new instance's).  The audio input is still synthetic.
+*/
+#include "./clap-host.h"
+#include "./event-generators.h"
+#include "./json-writer.h"
+
+#include "signalsmith-clap/event-capture.h"
+#include "signalsmith-clap/histogram.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+struct Options {
+	std::string clapPath;
+	std::vector<std::string> pluginIds, replays;
+	std::vector<double> sampleRates{48000};
+	std::vector<uint32_t> blockSizes{256};
+	std::vector<int> sampleBits{32}, inPlace{0};
+	double seconds = 10, warmupSeconds = 0.5;
+	double notesPerSecond = 8, paramsPerSecond = 0;
+	unsigned seed = 1;
+	std::string output;
+};
+
+template<class T>
+static std::vector<T> parseList(const std::string &str) {
+	std::vector<T> result;
+	size_t start = 0;
+	while (start <= str.size()) {
+		size_t end = str.find(',', start);
+		if (end == std::string::npos) end = str.size();
+		if (end > start) result.push_back(T(std::strtod(str.substr(start, end - start).c_str(), nullptr)));
+		start = end + 1;
+	}
+	return result;
+}
+
+static bool parseArgs(int argc, char **argv, Options &options) {
+	for (int i = 1; i < argc; ++i) {
+		std::string arg = argv[i];
+		if (i + 1 >= argc) {
+			std::fprintf(stderr, "missing value for %s\n", arg.c_str());
+			return false;
+		}
+		std::string value = argv[++i];
+		if (arg == "--clap") {
+			options.clapPath = value;
+		} else if (arg == "--plugin") {
+			options.pluginIds.push_back(value);
+		} else if (arg == "--replay") {
+			options.replays.push_back(value);
+		} else if (arg == "--sample-rate") {
+			options.sampleRates = parseList<double>(value);
+		} else if (arg == "--block-size") {
+			options.blockSizes = parseList<uint32_t>(value);
+		} else if (arg == "--sample-bits") {
+			options.sampleBits = parseList<int>(value);
+		} else if (arg == "--in-place") {
+			options.inPlace = parseList<int>(value);
+		} else if (arg == "--seconds") {
+			options.seconds = std::strtod(value.c_str(), nullptr);
+		} else if (arg == "--warmup") {
+			options.warmupSeconds = std::strtod(value.c_str(), nullptr);
+		} else if (arg == "--notes-per-second") {
+			options.notesPerSecond = std::strtod(value.c_str(), nullptr);
+		} else if (arg == "--params-per-second") {
+			options.paramsPerSecond = std::strtod(value.c_str(), nullptr);
+		} else if (arg == "--seed") {
+			options.seed = unsigned(std::strtoul(value.c_str(), nullptr, 10));
+		} else if (arg == "--output") {
+			options.output = value;
+		} else {
+			std::fprintf(stderr, "unknown option: %s\n", arg.c_str());
+			return false;
+		}
+	}
+	return true;
+}
+
+struct RunResult {
+	bool ok = false;
+	uint64_t blocks = 0, outputEvents = 0, droppedBlocks = 0;
+	bool using64 = false;
+	double audioSeconds = 0, wallSeconds = 0;
+	signalsmith::clap::AtomicHistogram blockNs;
+};
+
+static void runBenchmark(const clap_plugin_factory *factory, const clap_plugin_descriptor *descriptor, double sampleRate, uint32_t blockSize, int sampleBits, bool inPlace, const Options &options, RunResult &result) {
+	HostedPlugin hosted{factory, descriptor->id};
+	if (!hosted) return;
+	hosted.sample64 = (sampleBits == 64);
+	hosted.inPlace = inPlace;
+	if (!hosted.activate(sampleRate, blockSize)) return;
+	result.using64 = hosted.using64;
+
+	RandomNotes notes{options.seed};
+	notes.notesPerSecond = hosted.noteInputDialects ? options.notesPerSecond : 0;
+	RandomParams params{hosted, options.seed};
+	params.changesPerSecond = options.paramsPerSecond;
+	std::default_random_engine random{options.seed};
+
+	uint64_t warmupBlocks = uint64_t(options.warmupSeconds*sampleRate/blockSize);
+	uint64_t blocks = uint64_t(std::ceil(options.seconds*sampleRate/blockSize));
+	for (uint64_t b = 0; b < warmupBlocks + blocks; ++b) {
+		fillNoise(hosted, blockSize, random);
+		notes.addEvents(hosted.eventsIn, hosted.steadyTime, blockSize, sampleRate);
+		params.addEvents(hosted.eventsIn, blockSize, sampleRate);
+		hosted.eventsIn.sortByTime(); // notes and params are each in order, but not together
+
+		auto status = hosted.process(blockSize);
+		double ns = hosted.processNs;
+		if (status == CLAP_PROCESS_ERROR) return;
+
+		if (b >= warmupBlocks) {
+			result.blockNs.add(ns);
+			result.wallSeconds += ns*1e-9;
+			++result.blocks;
+		}
+		hosted.mainThread();
+	}
+	result.audioSeconds = double(result.blocks)*blockSize/sampleRate;
+	result.outputEvents = hosted.eventsOut.count;
+	result.ok = true;
+}
+
+// Param cookies are only valid for the instance which made them
+struct CookieMap {
+	CookieMap(const HostedPlugin &hosted) {
+		if (auto *params = hosted.extension<clap_plugin_params>(CLAP_EXT_PARAMS)) {
+			for (uint32_t i = 0; i < params->count(hosted.plugin); ++i) {
+				clap_param_info info;
+				if (params->get_info(hosted.plugin, i, &info)) cookies[info.id] = info.cookie;
+			}
+		}
+	}
+
+	void add(InputEventList &events, const clap_event_header *event) {
+		if (event->space_id == CLAP_CORE_EVENT_SPACE_ID && event->type == CLAP_EVENT_PARAM_VALUE) {
+			auto paramEvent = *(const clap_event_param_value *)event;
+			paramEvent.cookie = cookie(paramEvent.param_id);
+			events.add(paramEvent);
+		} else if (event->space_id == CLAP_CORE_EVENT_SPACE_ID && event->type == CLAP_EVENT_PARAM_MOD) {
+			auto modEvent = *(const clap_event_param_mod *)event;
+			modEvent.cookie = cookie(modEvent.param_id);
+			events.add(modEvent);
+		} else {
+			events.addHeader(event);
+		}
+	}
+private:
+	std::map<clap_id, void *> cookies;
+	void * cookie(clap_id id) const {
+		auto iter = cookies.find(id);
+		return (iter == cookies.end()) ? nullptr : iter->second;
+	}
+};
+
+// Replays a captured event stream - re-activating whenever the original was
+static void runReplay(const clap_plugin_factory *factory, const std::string &path, const Options &options, RunResult &result, std::string &pluginId) {
+	signalsmith::clap::EventCapture::Reader reader{path};
+	if (!reader) return;
+	std::unique_ptr<HostedPlugin> hosted;
+	std::unique_ptr<CookieMap> cookies;
+	std::default_random_engine random{options.seed};
+	double sampleRate = 0;
+	while (reader.next()) {
+		if (reader.tag == signalsmith::clap::EventCapture::tagActivate) {
+			if (!hosted) {
+				pluginId = reader.pluginId;
+				hosted.reset(new HostedPlugin{factory, pluginId.c_str()});
+				if (!*hosted) return;
+				// Replays only use the first of each
+				hosted->sample64 = (!options.sampleBits.empty() && options.sampleBits[0] == 64);
+				hosted->inPlace = (!options.inPlace.empty() && options.inPlace[0]);
+				cookies.reset(new CookieMap{*hosted});
+			}
+			auto &record = reader.activateRecord;
+			sampleRate = record.sampleRate;
+			// Start from the state the original had when it was activated
+			hosted->deactivate();
+			if (!reader.state.empty() && !hosted->loadState(reader.state.data(), reader.state.size())) return;
+			if (!hosted->activate(record.sampleRate, record.maxFrames, record.minFrames)) return;
+			result.using64 = hosted->using64;
+		} else if (reader.tag == signalsmith::clap::EventCapture::tagBlock) {
+			if (!hosted) return;
+			auto &record = reader.blockRecord;
+			result.droppedBlocks += record.droppedBefore;
+			fillNoise(*hosted, record.frames, random);
+			for (size_t i = 0; i < reader.eventCount(); ++i) cookies->add(hosted->eventsIn, reader.event(i));
+			hosted->steadyTime = record.steadyTime;
+
+			auto status = hosted->process(record.frames);
+			double ns = hosted->processNs;
+			if (status == CLAP_PROCESS_ERROR) return;
+
+			result.blockNs.add(ns);
+			result.wallSeconds += ns*1e-9;
+			result.audioSeconds += record.frames/sampleRate;
+			++result.blocks;
+			hosted->mainThread();
+		}
+	}
+	if (!hosted) return;
+	result.outputEvents = hosted->eventsOut.count;
+	result.ok = true;
+}
+
+static void writeTimings(JsonWriter &json, const RunResult &result) {
+	json.field("sampleBits", result.using64 ? 64 : 32);
+	json.field("blocks", (unsigned long long)result.blocks);
+	json.field("audioSeconds", result.audioSeconds);
+	json.field("wallSeconds", result.wallSeconds);
+	json.field("realtimeFactor", result.audioSeconds/result.wallSeconds);
+	json.field("outputEvents", (unsigned long long)result.outputEvents);
+	json.key("blockNs").openObject();
+	json.field("p50", result.blockNs.percentile(0.5));
+	json.field("p90", result.blockNs.percentile(0.9));
+	json.field("p99", result.blockNs.percentile(0.99));
+	json.field("max", result.blockNs.percentile(1));
+	json.close();
+}
+
+int main(int argc, char **argv) {
+	Options options;
+	if (!parseArgs(argc, argv, options)) return 1;
+
+	std::unique_ptr<PluginLibrary> library;
+	if (options.clapPath.empty()) {
+		library.reset(new PluginLibrary());
+	} else {
+		library.reset(new PluginLibrary(options.clapPath));
+	}
+	auto *factory = library->factory();
+	if (!factory) {
+		std::fprintf(stderr, "couldn't load plugins: %s\n", library->error.c_str());
+		return 1;
+	}
+
+	std::FILE *out = stdout;
+	if (!options.output.empty()) {
+		out = std::fopen(options.output.c_str(), "w");
+		if (!out) {
+			std::fprintf(stderr, "couldn't write %s\n", options.output.c_str());
+			return 1;
+		}
+	}
+
+	bool allOk = true;
+	{
+		JsonWriter json{out};
+		json.openObject();
+		json.field("seconds", options.seconds);
+		json.field("notesPerSecond", options.notesPerSecond);
+		json.field("paramsPerSecond", options.paramsPerSecond);
+		json.key("runs").openArray();
+		for (auto &path : options.replays) {
+			RunResult result;
+			std::string pluginId;
+			runReplay(factory, path, options, result, pluginId);
+			allOk = allOk && result.ok;
+
+			json.openObject();
+			json.field("replay", path);
+			json.field("plugin", pluginId);
+			json.field("ok", result.ok);
+			if (result.ok) {
+				writeTimings(json, result);
+				json.field("droppedBlocks", (unsigned long long)result.droppedBlocks);
+			}
+			json.close();
+		}
+		// Synthetic runs, unless we're replaying
+		auto descriptors = library->descriptors();
+		if (!options.replays.empty()) descriptors.clear();
+		for (auto *descriptor : descriptors) {
+			if (!options.pluginIds.empty()) {
+				bool found = false;
+				for (auto &id : options.pluginIds) found = found || (id == descriptor->id);
+				if (!found) continue;
+			}
+			for (double sampleRate : options.sampleRates) {
+				for (uint32_t blockSize : options.blockSizes) {
+					for (int sampleBits : options.sampleBits) {
+						for (int inPlace : options.inPlace) {
+							RunResult result;
+							runBenchmark(factory, descriptor, sampleRate, blockSize, sampleBits, inPlace, options, result);
+							allOk = allOk && result.ok;
+
+							json.openObject();
+							json.field("plugin", descriptor->id);
+							json.field("sampleRate", sampleRate);
+							json.field("blockSize", blockSize);
+							json.field("inPlace", bool(inPlace));
+							json.field("ok", result.ok);
+							if (result.ok) writeTimings(json, result);
+							json.close();
+						}
+					}
+				}
+			}
+		}
+	}
+	if (out != stdout) std::fclose(out);
+	return allOk ? 0 : 2;
+}
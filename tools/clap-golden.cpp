@@ -0,0 +1,669 @@
+/* Golden-render regression check: renders fixed scenarios through every plugin, and compares compact fingerprints of the output against recorded ones.
+
+	clap-golden --record [--golden-dir golden] [--clap path] [--plugin id]...
+	clap-golden [--golden-dir golden] [--tolerance-db 0.05] [--event-tolerance 0.1] [--exact] [--output report.json]
+
+Scenarios (whichever apply to each plugin):
+	audio: a sine sweep plus noise into the main input
+	notes: a fixed sequence of chords, runs and overlapping notes
+	automation: the above, plus every parameter being stepped through its range
+
+Everything is deterministic (its own random generator, fixed sample-rate and block size).  The fingerprint is, for each block and channel: RMS, peak, and octave-band energies (in dB, to 0.01dB), plus a hash of the exact sample values (and output events) for the whole block.  Output events also get their own per-block summary: how many of each kind, and a hash of their types, times and targets (note/param IDs, keys etc.) but not their values.
+
+Comparing passes if every level is within `--tolerance-db` and every block's events have the same structure (so approximate kernels can be accepted), or with `--exact`, only if every block's hash matches too.  Recording renders everything twice, and any blocks which differ (e.g. the note plugin's randomised output) are only compared approximately: their events just need the same total count of each kind, within `--event-tolerance` (as a proportion).  It exits with an error if anything fails (or is missing).
+
+In `RT_GUARD` builds (e.g. the `clap-golden-rt-guard` target), any render where the plugin's `perf-stats` reports audio-thread allocations or mutex locks fails too (when recording as well as comparing).
+*/
+#include "./clap-host.h"
+#include "./json-writer.h"
+
+#include "signalsmith-clap/perf-stats.h"
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+static constexpr double sampleRate = 48000;
+static constexpr uint32_t blockSize = 512;
+static constexpr size_t bandCount = 8;
+static constexpr double floorDb = -120;
+
+struct Options {
+	std::string clapPath, goldenDir = "golden", output;
+	std::vector<std::string> pluginIds;
+	bool record = false, exact = false;
+	double toleranceDb = 0.05, eventTolerance = 0.1;
+	double seconds = 4;
+};
+
+static bool parseArgs(int argc, char **argv, Options &options) {
+	for (int i = 1; i < argc; ++i) {
+		std::string arg = argv[i];
+		if (arg == "--record") {
+			options.record = true;
+			continue;
+		} else if (arg == "--exact") {
+			options.exact = true;
+			continue;
+		}
+		if (i + 1 >= argc) {
+			std::fprintf(stderr, "missing value for %s\n", arg.c_str());
+			return false;
+		}
+		std::string value = argv[++i];
+		if (arg == "--clap") {
+			options.clapPath = value;
+		} else if (arg == "--plugin") {
+			options.pluginIds.push_back(value);
+		} else if (arg == "--golden-dir") {
+			options.goldenDir = value;
+		} else if (arg == "--tolerance-db") {
+			options.toleranceDb = std::strtod(value.c_str(), nullptr);
+		} else if (arg == "--event-tolerance") {
+			options.eventTolerance = std::strtod(value.c_str(), nullptr);
+		} else if (arg == "--seconds") {
+			options.seconds = std::strtod(value.c_str(), nullptr);
+		} else if (arg == "--output") {
+			options.output = value;
+		} else {
+			std::fprintf(stderr, "unknown option: %s\n", arg.c_str());
+			return false;
+		}
+	}
+	return true;
+}
+
+// Our own generator, since `std::` distributions aren't the same on every platform
+struct Lcg {
+	uint32_t state;
+
+	float unit() {
+		state = state*1664525u + 1013904223u;
+		return (state>>8)*(1.0f/16777216);
+	}
+	float bipolar() {
+		return unit()*2 - 1;
+	}
+};
+
+/* ---- Fingerprints ---- */
+
+struct ChannelPrint {
+	int16_t rms, peak; // centi-dB
+	int16_t bands[bandCount];
+};
+enum EventKind {kindNoteOn, kindNoteEnd, kindExpression, kindParam, kindMidi, kindOther, eventKinds};
+static const char * const eventKindNames[eventKinds] = {"noteOn", "noteEnd", "expression", "param", "midi", "other"};
+struct EventPrint {
+	uint32_t structure; // types, times and targets (not values) - or `Fingerprint::unstable`
+	uint16_t counts[eventKinds];
+};
+struct Fingerprint {
+	static constexpr uint32_t unstable = 0; // blocks which weren't the same when rendered twice (e.g. randomised output)
+
+	uint32_t channels = 0;
+	std::vector<uint32_t> hashes; // one per block, or `unstable`
+	std::vector<ChannelPrint> prints; // `channels` per block
+	std::vector<EventPrint> events; // one per block
+
+	size_t blocks() const {
+		return hashes.size();
+	}
+
+	struct FileHeader {
+		char magic[8] = {'S', 'S', 'G', 'O', 'L', 'D', 'E', 'N'};
+		uint32_t version = 2, blockSize = ::blockSize, channels = 0, blocks = 0;
+		double sampleRate = ::sampleRate;
+	};
+
+	bool write(const std::string &path) const {
+		std::FILE *file = std::fopen(path.c_str(), "wb");
+		if (!file) return false;
+		FileHeader header;
+		header.channels = channels;
+		header.blocks = uint32_t(blocks());
+		bool ok = std::fwrite(&header, sizeof(header), 1, file) == 1;
+		ok = ok && std::fwrite(hashes.data(), sizeof(uint32_t), hashes.size(), file) == hashes.size();
+		ok = ok && std::fwrite(prints.data(), sizeof(ChannelPrint), prints.size(), file) == prints.size();
+		ok = ok && std::fwrite(events.data(), sizeof(EventPrint), events.size(), file) == events.size();
+		std::fclose(file);
+		return ok;
+	}
+	bool read(const std::string &path) {
+		std::FILE *file = std::fopen(path.c_str(), "rb");
+		if (!file) return false;
+		FileHeader expected, header;
+		bool ok = std::fread(&header, sizeof(header), 1, file) == 1;
+		ok = ok && !std::memcmp(header.magic, expected.magic, 8) && header.version == expected.version;
+		ok = ok && header.blockSize == expected.blockSize && header.sampleRate == expected.sampleRate;
+		if (ok) {
+			channels = header.channels;
+			hashes.resize(header.blocks);
+			prints.resize(size_t(header.blocks)*channels);
+			events.resize(header.blocks);
+			ok = std::fread(hashes.data(), sizeof(uint32_t), hashes.size(), file) == hashes.size();
+			ok = ok && std::fread(prints.data(), sizeof(ChannelPrint), prints.size(), file) == prints.size();
+			ok = ok && std::fread(events.data(), sizeof(EventPrint), events.size(), file) == events.size();
+		}
+		std::fclose(file);
+		return ok;
+	}
+};
+
+// In-place radix-2 FFT
+static void fft(std::vector<std::complex<double>> &data) {
+	size_t n = data.size();
+	for (size_t i = 1, j = 0; i < n; ++i) {
+		size_t bit = n>>1;
+		for (; j&bit; bit >>= 1) j ^= bit;
+		j ^= bit;
+		if (i < j) std::swap(data[i], data[j]);
+	}
+	for (size_t len = 2; len <= n; len <<= 1) {
+		std::complex<double> step = std::polar(1.0, -2*M_PI/len);
+		for (size_t i = 0; i < n; i += len) {
+			std::complex<double> w = 1;
+			for (size_t k = 0; k < len/2; ++k) {
+				auto a = data[i + k], b = data[i + k + len/2]*w;
+				data[i + k] = a + b;
+				data[i + k + len/2] = a - b;
+				w *= step;
+			}
+		}
+	}
+}
+
+static int16_t centiDb(double energy) {
+	double db = (energy > 0) ? 10*std::log10(energy) : floorDb;
+	return int16_t(std::round(std::max(db, floorDb)*100));
+}
+
+template<class V>
+static void hashValue(uint32_t &hash, V v) {
+	unsigned char bytes[sizeof(V)];
+	std::memcpy(bytes, &v, sizeof(V));
+	for (auto b : bytes) hash = (hash ^ b)*16777619u;
+}
+// Field-by-field for core events, since padding bytes are arbitrary and cookies are pointers
+static void hashEvent(uint32_t &hash, const clap_event_header *header) {
+	hashValue(hash, header->time);
+	hashValue(hash, header->type);
+	if (header->space_id != CLAP_CORE_EVENT_SPACE_ID) {
+		auto *bytes = (const unsigned char *)header;
+		for (uint32_t b = sizeof(clap_event_header); b < header->size; ++b) hash = (hash ^ bytes[b])*16777619u;
+		return;
+	}
+	switch (header->type) {
+		case CLAP_EVENT_NOTE_ON: case CLAP_EVENT_NOTE_OFF: case CLAP_EVENT_NOTE_CHOKE: case CLAP_EVENT_NOTE_END: {
+			auto &e = *(const clap_event_note *)header;
+			for (auto v : {e.note_id, int32_t(e.port_index), int32_t(e.channel), int32_t(e.key)}) hashValue(hash, v);
+			hashValue(hash, e.velocity);
+			break;
+		}
+		case CLAP_EVENT_NOTE_EXPRESSION: {
+			auto &e = *(const clap_event_note_expression *)header;
+			for (auto v : {e.expression_id, e.note_id, int32_t(e.port_index), int32_t(e.channel), int32_t(e.key)}) hashValue(hash, v);
+			hashValue(hash, e.value);
+			break;
+		}
+		case CLAP_EVENT_PARAM_VALUE: case CLAP_EVENT_PARAM_MOD: {
+			// `value` and `amount` are in the same place
+			auto &e = *(const clap_event_param_value *)header;
+			hashValue(hash, e.param_id);
+			for (auto v : {e.note_id, int32_t(e.port_index), int32_t(e.channel), int32_t(e.key)}) hashValue(hash, v);
+			hashValue(hash, e.value);
+			break;
+		}
+		case CLAP_EVENT_PARAM_GESTURE_BEGIN: case CLAP_EVENT_PARAM_GESTURE_END:
+			hashValue(hash, ((const clap_event_param_gesture *)header)->param_id);
+			break;
+		case CLAP_EVENT_MIDI: {
+			auto &e = *(const clap_event_midi *)header;
+			hashValue(hash, e.port_index);
+			for (auto b : e.data) hashValue(hash, b);
+			break;
+		}
+	}
+}
+
+// Just what the event is and where it's aimed, so approximate kernels (e.g. slightly different velocities) still match
+static EventKind hashEventStructure(uint32_t &hash, const clap_event_header *header) {
+	hashValue(hash, header->time);
+	hashValue(hash, header->space_id);
+	hashValue(hash, header->type);
+	if (header->space_id != CLAP_CORE_EVENT_SPACE_ID) return kindOther;
+	switch (header->type) {
+		case CLAP_EVENT_NOTE_ON: case CLAP_EVENT_NOTE_OFF: case CLAP_EVENT_NOTE_CHOKE: case CLAP_EVENT_NOTE_END: {
+			auto &e = *(const clap_event_note *)header;
+			for (auto v : {e.note_id, int32_t(e.port_index), int32_t(e.channel), int32_t(e.key)}) hashValue(hash, v);
+			return (header->type == CLAP_EVENT_NOTE_ON) ? kindNoteOn : kindNoteEnd;
+		}
+		case CLAP_EVENT_NOTE_EXPRESSION: {
+			auto &e = *(const clap_event_note_expression *)header;
+			for (auto v : {e.expression_id, e.note_id, int32_t(e.port_index), int32_t(e.channel), int32_t(e.key)}) hashValue(hash, v);
+			return kindExpression;
+		}
+		case CLAP_EVENT_PARAM_VALUE: case CLAP_EVENT_PARAM_MOD: {
+			auto &e = *(const clap_event_param_value *)header;
+			hashValue(hash, e.param_id);
+			for (auto v : {e.note_id, int32_t(e.port_index), int32_t(e.channel), int32_t(e.key)}) hashValue(hash, v);
+			return kindParam;
+		}
+		case CLAP_EVENT_PARAM_GESTURE_BEGIN: case CLAP_EVENT_PARAM_GESTURE_END:
+			hashValue(hash, ((const clap_event_param_gesture *)header)->param_id);
+			return kindParam;
+		case CLAP_EVENT_MIDI: {
+			// Status (type/channel) and key/controller number, but not velocity/value
+			auto &e = *(const clap_event_midi *)header;
+			hashValue(hash, e.port_index);
+			hashValue(hash, e.data[0]);
+			if ((e.data[0]&0xF0) < 0xC0) hashValue(hash, e.data[1]);
+			return kindMidi;
+		}
+		case CLAP_EVENT_MIDI_SYSEX: case CLAP_EVENT_MIDI2:
+			return kindMidi;
+	}
+	return kindOther;
+}
+
+static void addBlock(Fingerprint &print, const std::vector<std::vector<float>> &channels, uint32_t frames, const InputEventList &outputEvents) {
+	uint32_t hash = 2166136261u; // FNV-1a, over the exact sample bits (and any output events)
+	EventPrint eventPrint{2166136261u, {}};
+	for (size_t i = 0; i < outputEvents.size(); ++i) {
+		hashEvent(hash, outputEvents.get(i));
+		auto kind = hashEventStructure(eventPrint.structure, outputEvents.get(i));
+		if (eventPrint.counts[kind] < 0xFFFF) ++eventPrint.counts[kind];
+	}
+	if (!eventPrint.structure) eventPrint.structure = 1;
+	print.events.push_back(eventPrint);
+	std::vector<std::complex<double>> spectrum(blockSize);
+	for (auto &channel : channels) {
+		ChannelPrint channelPrint;
+		double sum2 = 0, peak = 0;
+		for (uint32_t i = 0; i < frames; ++i) {
+			uint32_t bits;
+			std::memcpy(&bits, &channel[i], 4);
+			for (int b = 0; b < 4; ++b) hash = (hash ^ ((bits>>(8*b))&0xFF))*16777619u;
+			double v = channel[i];
+			sum2 += v*v;
+			peak = std::max(peak, std::abs(v));
+		}
+		channelPrint.rms = centiDb(sum2/frames);
+		channelPrint.peak = centiDb(peak*peak);
+
+		// Hann-windowed, then summed into octave bands (bins 1-2, 2-4, ... 128-256)
+		for (uint32_t i = 0; i < blockSize; ++i) {
+			double window = 0.5 - 0.5*std::cos(2*M_PI*(i + 0.5)/blockSize);
+			spectrum[i] = (i < frames) ? channel[i]*window : 0.0;
+		}
+		fft(spectrum);
+		for (size_t band = 0; band < bandCount; ++band) {
+			double energy = 0;
+			for (size_t bin = size_t(1)<<band; bin < (size_t(2)<<band) && bin <= blockSize/2; ++bin) energy += std::norm(spectrum[bin]);
+			channelPrint.bands[band] = centiDb(energy/(blockSize*blockSize));
+		}
+		print.prints.push_back(channelPrint);
+	}
+	print.hashes.push_back(hash ? hash : 1);
+}
+
+/* ---- Scenarios ---- */
+
+struct Scenario {
+	const char *name;
+	bool audio, notes, automation;
+};
+static const Scenario scenarios[] = {
+	{"audio", true, false, false},
+	{"notes", false, true, false},
+	{"automation", true, true, true}
+};
+
+static bool applies(const Scenario &scenario, const HostedPlugin &hosted) {
+	bool hasAudio = !hosted.audioInputs.empty(), hasNotes = hosted.noteInputDialects&CLAP_NOTE_DIALECT_CLAP;
+	if (scenario.automation) return hasAudio || hasNotes;
+	return (scenario.audio && hasAudio) || (scenario.notes && hasNotes);
+}
+
+static clap_event_note noteEvent(uint16_t type, uint32_t time, int16_t key, int32_t noteId, double velocity) {
+	return {
+		.header={
+			.size=sizeof(clap_event_note),
+			.time=time,
+			.space_id=CLAP_CORE_EVENT_SPACE_ID,
+			.type=type,
+			.flags=0
+		},
+		.note_id=noteId,
+		.port_index=0,
+		.channel=0,
+		.key=key,
+		.velocity=velocity
+	};
+}
+
+// A fixed note pattern, one "step" every 6000 samples: chords, a fast run, and overlapping long notes
+struct NotePattern {
+	struct Note {
+		uint64_t start, end;
+		int16_t key;
+		double velocity;
+	};
+	std::vector<Note> notes;
+
+	NotePattern(uint64_t totalFrames) {
+		Lcg random{12345};
+		uint64_t step = 6000;
+		for (uint64_t t = 0, index = 0; t + step < totalFrames; t += step, ++index) {
+			switch (index%3) {
+				case 0: // chord
+					for (int16_t k : {48, 52, 55, 60}) notes.push_back({t, t + step*2/3, int16_t(k + index%5), 0.6});
+					break;
+				case 1: // fast run
+					for (int i = 0; i < 8; ++i) notes.push_back({t + i*step/8, t + (i + 1)*step/8, int16_t(60 + i*2), 0.3 + 0.08*i});
+					break;
+				default: // overlapping, random velocities
+					for (int i = 0; i < 3; ++i) notes.push_back({t + i*step/4, t + step*2, int16_t(40 + 7*i), 0.2 + 0.8*random.unit()});
+			}
+		}
+	}
+
+	// Sorted by time within the block
+	void addEvents(InputEventList &events, uint64_t blockStart, uint32_t frames) const {
+		std::vector<clap_event_note> blockEvents;
+		for (size_t i = 0; i < notes.size(); ++i) {
+			auto &note = notes[i];
+			if (note.start >= blockStart && note.start < blockStart + frames) blockEvents.push_back(noteEvent(CLAP_EVENT_NOTE_ON, uint32_t(note.start - blockStart), note.key, int32_t(i), note.velocity));
+			if (note.end >= blockStart && note.end < blockStart + frames) blockEvents.push_back(noteEvent(CLAP_EVENT_NOTE_OFF, uint32_t(note.end - blockStart), note.key, int32_t(i), 0));
+		}
+		std::stable_sort(blockEvents.begin(), blockEvents.end(), [](auto &a, auto &b){
+			return a.header.time < b.header.time;
+		});
+		for (auto &e : blockEvents) events.add(e);
+	}
+};
+
+struct RenderInfo {
+	bool applicable = true;
+	// audio-thread allocations/locks from `perf-stats`, or -1 if they aren't counted
+	int64_t allocations = -1, locks = -1;
+};
+
+static bool render(const clap_plugin_factory *factory, const char *pluginId, const Scenario &scenario, const Options &options, Fingerprint &print, RenderInfo &info) {
+	HostedPlugin hosted{factory, pluginId};
+	if (!hosted || !hosted.activate(sampleRate, blockSize)) return false;
+	info.applicable = applies(scenario, hosted);
+	if (!info.applicable) return true;
+	// Note-only plugins just get their output events hashed
+	std::vector<std::vector<float>> noChannels;
+	auto &outputChannels = hosted.audioOutputs.empty() ? noChannels : hosted.audioOutputs[0].channels;
+	print.channels = uint32_t(outputChannels.size());
+	hosted.eventsOut.keep = true;
+
+	std::vector<clap_param_info> params;
+	if (auto *paramsExt = hosted.extension<clap_plugin_params>(CLAP_EXT_PARAMS)) {
+		for (uint32_t i = 0; i < paramsExt->count(hosted.plugin); ++i) {
+			clap_param_info info;
+			if (paramsExt->get_info(hosted.plugin, i, &info) && !(info.flags&CLAP_PARAM_IS_READONLY)) params.push_back(info);
+		}
+	}
+
+	uint64_t totalFrames = uint64_t(options.seconds*sampleRate);
+	NotePattern pattern{totalFrames};
+	Lcg noise{1};
+	double phase = 0;
+	uint64_t blockIndex = 0;
+	for (uint64_t blockStart = 0; blockStart < totalFrames; blockStart += blockSize, ++blockIndex) {
+		uint32_t frames = uint32_t(std::min<uint64_t>(blockSize, totalFrames - blockStart));
+		for (auto &port : hosted.audioInputs) {
+			for (size_t c = 0; c < port.channels.size(); ++c) {
+				auto &channel = port.channels[c];
+				for (uint32_t i = 0; i < frames; ++i) {
+					if (!scenario.audio) {
+						channel[i] = 0;
+						continue;
+					}
+					// Exponential sweep 50Hz-10kHz over the render, plus quiet noise
+					double t = double(blockStart + i)/totalFrames;
+					double freq = 50*std::pow(200.0, t);
+					if (c == 0) phase += 2*M_PI*freq/sampleRate;
+					channel[i] = float(0.4*std::sin(phase + c*0.5) + 0.05*noise.bipolar());
+				}
+			}
+		}
+		if (scenario.notes && hosted.noteInputDialects) pattern.addEvents(hosted.eventsIn, blockStart, frames);
+		// Every 24 blocks, step one parameter (round-robin) through 0, 1/3, 2/3, 1 of its range
+		if (scenario.automation && !params.empty() && blockIndex%24 == 12) {
+			auto &info = params[(blockIndex/24)%params.size()];
+			double unit = double((blockIndex/24/params.size())%4)/3;
+			double value = info.min_value + (info.max_value - info.min_value)*unit;
+			if (info.flags&CLAP_PARAM_IS_STEPPED) value = std::round(value);
+			hosted.eventsIn.add(clap_event_param_value{
+				.header={
+					.size=sizeof(clap_event_param_value),
+					.time=frames/2,
+					.space_id=CLAP_CORE_EVENT_SPACE_ID,
+					.type=CLAP_EVENT_PARAM_VALUE,
+					.flags=0
+				},
+				.param_id=info.id,
+				.cookie=info.cookie,
+				.note_id=-1,
+				.port_index=-1,
+				.channel=-1,
+				.key=-1,
+				.value=value
+			});
+		}
+		hosted.eventsIn.sortByTime();
+
+		if (hosted.process(frames) == CLAP_PROCESS_ERROR) return false;
+		addBlock(print, outputChannels, frames, hosted.eventsOut.events);
+		hosted.eventsOut.clear();
+		hosted.mainThread();
+	}
+
+	using namespace signalsmith::clap;
+	if (auto *perfStats = hosted.extension<clap_plugin_perf_stats>(CLAP_EXT_PERF_STATS)) {
+		clap_perf_stats stats;
+		if (perfStats->get(hosted.plugin, &stats) && (stats.flags&CLAP_PERF_STATS_HAS_ALLOCATIONS)) {
+			info.allocations = int64_t(stats.audio_thread_allocations);
+			info.locks = int64_t(stats.audio_thread_locks);
+		}
+	}
+	return true;
+}
+
+/* ---- Comparison ---- */
+
+struct Comparison {
+	bool ok = true, bitExact = true;
+	double maxRmsDiff = 0, maxPeakDiff = 0, maxBandDiff = 0;
+	int64_t firstFailingBlock = -1;
+	// Events in blocks which should match, and totals for the ones which can't
+	uint64_t eventBlocksDiffering = 0;
+	uint64_t unstableTotals[eventKinds] = {}, currentTotals[eventKinds] = {};
+	std::string error;
+};
+
+static void compare(const Fingerprint &golden, const Fingerprint &current, const Options &options, Comparison &result) {
+	if (golden.channels != current.channels || golden.blocks() != current.blocks()) {
+		result.ok = result.bitExact = false;
+		result.error = "different length or channel count";
+		return;
+	}
+	for (size_t b = 0; b < golden.blocks(); ++b) {
+		bool blockOk = true;
+		if (golden.hashes[b] != Fingerprint::unstable && golden.hashes[b] != current.hashes[b]) {
+			result.bitExact = false;
+			if (options.exact) blockOk = false;
+		}
+		auto &gEvents = golden.events[b], &pEvents = current.events[b];
+		if (gEvents.structure == Fingerprint::unstable) {
+			for (size_t k = 0; k < eventKinds; ++k) {
+				result.unstableTotals[k] += gEvents.counts[k];
+				result.currentTotals[k] += pEvents.counts[k];
+			}
+		} else if (gEvents.structure != pEvents.structure || std::memcmp(gEvents.counts, pEvents.counts, sizeof(gEvents.counts))) {
+			++result.eventBlocksDiffering;
+			blockOk = false;
+		}
+		for (size_t c = 0; c < golden.channels; ++c) {
+			auto &g = golden.prints[b*golden.channels + c], &p = current.prints[b*golden.channels + c];
+			double rmsDiff = std::abs(g.rms - p.rms)*0.01, peakDiff = std::abs(g.peak - p.peak)*0.01;
+			result.maxRmsDiff = std::max(result.maxRmsDiff, rmsDiff);
+			result.maxPeakDiff = std::max(result.maxPeakDiff, peakDiff);
+			if (rmsDiff > options.toleranceDb || peakDiff > options.toleranceDb) blockOk = false;
+			for (size_t band = 0; band < bandCount; ++band) {
+				double bandDiff = std::abs(g.bands[band] - p.bands[band])*0.01;
+				result.maxBandDiff = std::max(result.maxBandDiff, bandDiff);
+				if (bandDiff > options.toleranceDb) blockOk = false;
+			}
+		}
+		if (!blockOk && result.ok) {
+			result.ok = false;
+			result.firstFailingBlock = int64_t(b);
+		}
+	}
+	for (size_t k = 0; k < eventKinds; ++k) {
+		double expected = double(result.unstableTotals[k]), diff = std::abs(double(result.currentTotals[k]) - expected);
+		// A little slack for small counts, where the proportion would be very noisy
+		if (diff > std::max(options.eventTolerance*expected, 2.0)) {
+			result.ok = false;
+			if (result.error.empty()) result.error = std::string("different number of ") + eventKindNames[k] + " events (in blocks with randomised output)";
+		}
+	}
+}
+
+int main(int argc, char **argv) {
+	Options options;
+	if (!parseArgs(argc, argv, options)) return 1;
+
+	std::unique_ptr<PluginLibrary> library;
+	if (options.clapPath.empty()) {
+		library.reset(new PluginLibrary());
+	} else {
+		library.reset(new PluginLibrary(options.clapPath));
+	}
+	auto *factory = library->factory();
+	if (!factory) {
+		std::fprintf(stderr, "couldn't load plugins: %s\n", library->error.c_str());
+		return 1;
+	}
+
+	std::FILE *out = stdout;
+	if (!options.output.empty()) {
+		out = std::fopen(options.output.c_str(), "w");
+		if (!out) {
+			std::fprintf(stderr, "couldn't write %s\n", options.output.c_str());
+			return 1;
+		}
+	}
+
+	bool allOk = true;
+	{
+		JsonWriter json{out};
+		json.openObject();
+		json.field("mode", options.record ? "record" : (options.exact ? "exact" : "tolerance"));
+		json.field("toleranceDb", options.toleranceDb);
+		json.key("results").openArray();
+		for (auto *descriptor : library->descriptors()) {
+			if (!options.pluginIds.empty()) {
+				bool found = false;
+				for (auto &id : options.pluginIds) found = found || (id == descriptor->id);
+				if (!found) continue;
+			}
+			for (auto &scenario : scenarios) {
+				Fingerprint print;
+				RenderInfo info;
+				bool rendered = render(factory, descriptor->id, scenario, options, print, info);
+				if (!info.applicable) continue;
+				std::string path = options.goldenDir + "/" + descriptor->id + "." + scenario.name + ".golden";
+
+				json.openObject();
+				json.field("plugin", descriptor->id);
+				json.field("scenario", scenario.name);
+				if (!rendered) {
+					json.field("ok", false);
+					json.field("error", "render failed");
+					allOk = false;
+				} else if (options.record) {
+					// Render again, so we know which blocks can't be compared exactly
+					Fingerprint second;
+					size_t unstableBlocks = 0;
+					RenderInfo secondInfo;
+					render(factory, descriptor->id, scenario, options, second, secondInfo);
+					// Once they've diverged (e.g. different random numbers), any later block might too - including the events' structure, even if it happened to match this time
+					bool diverged = false;
+					for (size_t b = 0; b < print.blocks(); ++b) {
+						diverged = diverged || b >= second.blocks() || second.hashes[b] != print.hashes[b];
+						if (diverged) {
+							print.hashes[b] = Fingerprint::unstable;
+							print.events[b].structure = Fingerprint::unstable;
+							++unstableBlocks;
+						}
+					}
+					bool written = print.write(path);
+					json.field("ok", written);
+					json.field("file", path);
+					json.field("blocks", (unsigned long long)print.blocks());
+					json.field("unstableBlocks", (unsigned long long)unstableBlocks);
+					allOk = allOk && written;
+				} else {
+					Fingerprint golden;
+					Comparison result;
+					if (!golden.read(path)) {
+						result.ok = result.bitExact = false;
+						result.error = "couldn't read " + path;
+					} else {
+						compare(golden, print, options, result);
+					}
+					allOk = allOk && result.ok;
+					json.field("ok", result.ok);
+					json.field("bitExact", result.bitExact);
+					if (!result.error.empty()) json.field("error", result.error);
+					json.key("maxDiffDb").openObject();
+					json.field("rms", result.maxRmsDiff);
+					json.field("peak", result.maxPeakDiff);
+					json.field("bands", result.maxBandDiff);
+					json.close();
+					json.field("eventBlocksDiffering", (unsigned long long)result.eventBlocksDiffering);
+					// Golden vs. current totals, from the blocks with randomised output
+					json.key("unstableEventCounts").openObject();
+					for (size_t k = 0; k < eventKinds; ++k) {
+						if (!result.unstableTotals[k] && !result.currentTotals[k]) continue;
+						json.key(eventKindNames[k]).openArray();
+						json.value((unsigned long long)result.unstableTotals[k]);
+						json.value((unsigned long long)result.currentTotals[k]);
+						json.close();
+					}
+					json.close();
+					if (result.firstFailingBlock >= 0) json.field("firstFailingBlock", (long long)result.firstFailingBlock);
+				}
+				if (info.allocations >= 0) {
+					json.field("audioThreadAllocations", (long long)info.allocations);
+					if (info.allocations > 0) {
+						std::fprintf(stderr, "%s (%s): %lld allocations in process()\n", descriptor->id, scenario.name, (long long)info.allocations);
+						allOk = false;
+					}
+				}
+				if (info.locks >= 0) {
+					json.field("audioThreadLocks", (long long)info.locks);
+					if (info.locks > 0) {
+						std::fprintf(stderr, "%s (%s): %lld mutex locks in process()\n", descriptor->id, scenario.name, (long long)info.locks);
+						allOk = false;
+					}
+				}
+				json.close();
+			}
+		}
+	}
+	if (out != stdout) std::fclose(out);
+	return allOk ? 0 : 2;
+}
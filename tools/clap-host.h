@@ -0,0 +1,416 @@
+#pragma once
+
+#include "clap/clap.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#if defined(_WIN32)
+#	define WIN32_LEAN_AND_MEAN
+#	include <windows.h>
+#else
+#	include <dlfcn.h>
+#	include <sys/stat.h>
+#endif
+
+// From `source/plugins.cpp`, when we're linked against the static library
+extern bool clapEntryInit(const char *path);
+extern void clapEntryDeinit();
+extern const void * clapEntryGetFactory(const char *factoryId);
+
+/* A CLAP entry point, either from the plugins we're linked against, or from a `.clap` loaded at runtime.
+
+	PluginLibrary library; // linked plugins
+	PluginLibrary library{"out/Release/example-plugins.clap"};
+	if (!library.factory()) ...
+*/
+struct PluginLibrary {
+	PluginLibrary() {
+		static const clap_plugin_entry linkedEntry{
+			.clap_version=CLAP_VERSION,
+			.init=clapEntryInit,
+			.deinit=clapEntryDeinit,
+			.get_factory=clapEntryGetFactory
+		};
+		init(&linkedEntry, "");
+	}
+	PluginLibrary(const std::string &path) {
+		std::string binary = path;
+#if defined(__APPLE__)
+		// A bundle: the binary is `Contents/MacOS/<name>`
+		struct stat info;
+		if (stat(path.c_str(), &info) == 0 && S_ISDIR(info.st_mode)) {
+			std::string name = path;
+			while (!name.empty() && name.back() == '/') name.pop_back();
+			name = name.substr(name.find_last_of('/') + 1);
+			name = name.substr(0, name.find_last_of('.'));
+			binary = path + "/Contents/MacOS/" + name;
+		}
+#endif
+#if defined(_WIN32)
+		auto module = LoadLibraryA(binary.c_str());
+		handle = module;
+		if (!module) return;
+		auto *entry = (const clap_plugin_entry *)GetProcAddress(module, "clap_entry");
+#else
+		handle = dlopen(binary.c_str(), RTLD_LOCAL|RTLD_NOW);
+		if (!handle) {
+			error = dlerror();
+			return;
+		}
+		auto *entry = (const clap_plugin_entry *)dlsym(handle, "clap_entry");
+#endif
+		if (!entry) {
+			error = "no clap_entry symbol";
+			return;
+		}
+		init(entry, path);
+	}
+	~PluginLibrary() {
+		if (entry) entry->deinit();
+#if defined(_WIN32)
+		if (handle) FreeLibrary((HMODULE)handle);
+#else
+		if (handle) dlclose(handle);
+#endif
+	}
+	PluginLibrary(const PluginLibrary &other) = delete;
+
+	const clap_plugin_factory * factory() const {
+		if (!entry) return nullptr;
+		return (const clap_plugin_factory *)entry->get_factory(CLAP_PLUGIN_FACTORY_ID);
+	}
+
+	std::vector<const clap_plugin_descriptor *> descriptors() const {
+		std::vector<const clap_plugin_descriptor *> result;
+		if (auto *f = factory()) {
+			for (uint32_t i = 0; i < f->get_plugin_count(f); ++i) {
+				if (auto *d = f->get_plugin_descriptor(f, i)) result.push_back(d);
+			}
+		}
+		return result;
+	}
+
+	std::string error;
+private:
+	void *handle = nullptr;
+	const clap_plugin_entry *entry = nullptr;
+
+	void init(const clap_plugin_entry *e, const std::string &path) {
+		if (!e->init(path.c_str())) {
+			error = "clap_entry.init() failed";
+			return;
+		}
+		entry = e;
+	}
+};
+
+// An input event list, which events are appended to (in time order, or call `.sortByTime()` afterwards)
+struct InputEventList {
+	const clap_input_events * list() const {
+		return &clapList;
+	}
+
+	template<class Event>
+	void add(const Event &event) {
+		addHeader(&event.header);
+	}
+	void addHeader(const clap_event_header *header) {
+		// Keep every event 8-byte aligned, since they contain `double`s
+		size_t offset = (bytes.size() + 7)&~size_t(7);
+		offsets.push_back(offset);
+		bytes.resize(offset + header->size);
+		std::memcpy(bytes.data() + offset, header, header->size);
+	}
+	void clear() {
+		bytes.clear();
+		offsets.clear();
+	}
+	void reserve(size_t eventCount, size_t byteCount) {
+		offsets.reserve(eventCount);
+		bytes.reserve(byteCount);
+	}
+	size_t size() const {
+		return offsets.size();
+	}
+	// For combining events from more than one source: same-time events stay in the order they were added
+	void sortByTime() {
+		std::stable_sort(offsets.begin(), offsets.end(), [&](size_t a, size_t b){
+			return ((const clap_event_header *)(bytes.data() + a))->time < ((const clap_event_header *)(bytes.data() + b))->time;
+		});
+	}
+	const clap_event_header * get(size_t index) const {
+		return (const clap_event_header *)(bytes.data() + offsets[index]);
+	}
+
+private:
+	std::vector<unsigned char> bytes;
+	std::vector<size_t> offsets;
+
+	const clap_input_events clapList{
+		.ctx=this,
+		.size=[](const clap_input_events *list) -> uint32_t {
+			return uint32_t(((const InputEventList *)list->ctx)->size());
+		},
+		.get=[](const clap_input_events *list, uint32_t index) -> const clap_event_header * {
+			auto &self = *(const InputEventList *)list->ctx;
+			if (index >= self.size()) return nullptr;
+			return self.get(index);
+		}
+	};
+};
+
+// Collects (or just counts) whatever the plugin outputs
+struct OutputEventList {
+	bool keep = false;
+	InputEventList events; // only filled if `keep` is set
+	uint64_t count = 0;
+
+	// Room for plenty of events, so keeping them doesn't allocate inside the plugin's `process()` (which `RT_GUARD` builds would count)
+	OutputEventList() {
+		events.reserve(4096, 4096*64);
+	}
+
+	const clap_output_events * list() const {
+		return &clapList;
+	}
+	void clear() {
+		events.clear();
+	}
+
+private:
+	const clap_output_events clapList{
+		.ctx=this,
+		.try_push=[](const clap_output_events *list, const clap_event_header *event) -> bool {
+			auto &self = *(OutputEventList *)list->ctx;
+			++self.count;
+			if (self.keep) self.events.addHeader(event);
+			return true;
+		}
+	};
+};
+
+/* One plugin instance, with a minimal single-threaded host around it.
+
+The "main thread" and "audio thread" are both whichever thread calls this - call `.mainThread()` between blocks, which calls `on_main_thread()` if the plugin asked for it.  Audio ports are discovered on `.activate()`, with a buffer for every channel (32-bit unless `sample64` is set, and separate for inputs/outputs unless `inPlace` is set).
+*/
+struct HostedPlugin {
+	struct AudioPort {
+		clap_audio_port_info info;
+		std::vector<std::vector<float>> channels;
+		std::vector<float *> pointers; // read outputs through these, since with `inPlace` they're the paired input's `channels`
+		std::vector<std::vector<double>> channels64; // only used with 64-bit buffers
+		std::vector<double *> pointers64;
+	};
+
+	const clap_plugin *plugin = nullptr;
+	std::vector<AudioPort> audioInputs, audioOutputs;
+	uint32_t noteInputDialects = 0; // 0 if there are no note inputs
+	InputEventList eventsIn;
+	OutputEventList eventsOut;
+
+	// Set these before `.activate()`: 64-bit buffers (only used if every port supports them), and giving `in_place_pair` ports the same buffers
+	bool sample64 = false, inPlace = false;
+	bool using64 = false; // whether we actually ended up with 64-bit buffers
+	// The last `process()` call, not counting the host converting to/from 64-bit
+	double processNs = 0;
+
+	std::atomic<bool> callbackRequested{false}, restartRequested{false}, processRequested{false};
+	int64_t steadyTime = 0;
+
+	HostedPlugin(const clap_plugin_factory *factory, const char *pluginId) {
+		plugin = factory->create_plugin(factory, &host, pluginId);
+		if (plugin && !plugin->init(plugin)) {
+			plugin->destroy(plugin);
+			plugin = nullptr;
+		}
+	}
+	~HostedPlugin() {
+		if (!plugin) return;
+		deactivate();
+		plugin->destroy(plugin);
+	}
+	HostedPlugin(const HostedPlugin &other) = delete;
+
+	explicit operator bool() const {
+		return plugin;
+	}
+
+	template<class Extension>
+	const Extension * extension(const char *extId) const {
+		return (const Extension *)plugin->get_extension(plugin, extId);
+	}
+
+	bool activate(double sampleRate, uint32_t maxBlock, uint32_t minBlock=1) {
+		deactivate();
+		scanPorts(maxBlock);
+		if (!plugin->activate(plugin, sampleRate, minBlock, maxBlock)) return false;
+		if (!plugin->start_processing(plugin)) {
+			plugin->deactivate(plugin);
+			return false;
+		}
+		active = true;
+		steadyTime = 0;
+		return true;
+	}
+	void deactivate() {
+		if (!active) return;
+		plugin->stop_processing(plugin);
+		plugin->deactivate(plugin);
+		active = false;
+	}
+
+	// Processes `frames` using the current `eventsIn`, which is then cleared
+	clap_process_status process(uint32_t frames) {
+		clap_process proc{
+			.steady_time=steadyTime,
+			.frames_count=frames,
+			.transport=nullptr,
+			.audio_inputs=inputBuffers.data(),
+			.audio_outputs=outputBuffers.data(),
+			.audio_inputs_count=uint32_t(inputBuffers.size()),
+			.audio_outputs_count=uint32_t(outputBuffers.size()),
+			.in_events=eventsIn.list(),
+			.out_events=eventsOut.list()
+		};
+		if (using64) {
+			for (auto &port : audioInputs) {
+				for (size_t c = 0; c < port.pointers.size(); ++c) {
+					std::copy(port.pointers[c], port.pointers[c] + frames, port.pointers64[c]);
+				}
+			}
+		}
+		auto start = std::chrono::steady_clock::now();
+		auto status = plugin->process(plugin, &proc);
+		processNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+		if (using64) {
+			for (auto &port : audioOutputs) {
+				for (size_t c = 0; c < port.pointers.size(); ++c) {
+					std::copy(port.pointers64[c], port.pointers64[c] + frames, port.pointers[c]);
+				}
+			}
+		}
+		steadyTime += frames;
+		eventsIn.clear();
+		return status;
+	}
+
+	// Loads saved state (e.g. from a file), if the plugin has `CLAP_EXT_STATE`
+	bool loadState(const void *data, size_t size) {
+		auto *stateExt = extension<clap_plugin_state>(CLAP_EXT_STATE);
+		if (!stateExt) return false;
+		struct Reader {
+			const unsigned char *bytes;
+			size_t size, pos = 0;
+		} reader{(const unsigned char *)data, size};
+		const clap_istream stream{
+			.ctx=&reader,
+			.read=[](const clap_istream *stream, void *buffer, uint64_t size) -> int64_t {
+				auto &reader = *(Reader *)stream->ctx;
+				size_t count = size_t(std::min<uint64_t>(size, reader.size - reader.pos));
+				std::memcpy(buffer, reader.bytes + reader.pos, count);
+				reader.pos += count;
+				return int64_t(count);
+			}
+		};
+		return stateExt->load(plugin, &stream);
+	}
+
+	// Call between blocks, outside any timing
+	void mainThread() {
+		if (callbackRequested.exchange(false)) plugin->on_main_thread(plugin);
+	}
+
+private:
+	bool active = false;
+	std::vector<clap_audio_buffer> inputBuffers, outputBuffers;
+
+	void scanPorts(uint32_t maxBlock) {
+		audioInputs.clear();
+		audioOutputs.clear();
+		if (auto *ports = extension<clap_plugin_audio_ports>(CLAP_EXT_AUDIO_PORTS)) {
+			for (int isInput = 0; isInput < 2; ++isInput) {
+				auto &list = isInput ? audioInputs : audioOutputs;
+				uint32_t count = ports->count(plugin, isInput);
+				for (uint32_t i = 0; i < count; ++i) {
+					AudioPort port;
+					if (!ports->get(plugin, i, isInput, &port.info)) continue;
+					port.channels.assign(port.info.channel_count, std::vector<float>(maxBlock));
+					list.push_back(std::move(port));
+				}
+			}
+		}
+		// Ports can't mix sample sizes if any of them say `CLAP_AUDIO_PORT_REQUIRES_COMMON_SAMPLE_SIZE`, so it's all or nothing
+		using64 = sample64;
+		for (auto *list : {&audioInputs, &audioOutputs}) {
+			for (auto &port : *list) using64 = using64 && (port.info.flags&CLAP_AUDIO_PORT_SUPPORTS_64BITS);
+		}
+		for (int isInput = 1; isInput >= 0; --isInput) { // inputs first, so outputs can share their buffers
+			auto &list = isInput ? audioInputs : audioOutputs;
+			auto &buffers = isInput ? inputBuffers : outputBuffers;
+			buffers.clear();
+			for (auto &port : list) {
+				port.pointers.clear();
+				port.pointers64.clear();
+				port.channels64.clear();
+				if (using64) port.channels64.assign(port.channels.size(), std::vector<double>(maxBlock));
+				const AudioPort *pair = nullptr;
+				if (!isInput && inPlace && port.info.in_place_pair != CLAP_INVALID_ID) {
+					for (auto &input : audioInputs) {
+						if (input.info.id == port.info.in_place_pair && input.channels.size() == port.channels.size()) pair = &input;
+					}
+				}
+				if (pair) {
+					port.pointers = pair->pointers;
+					port.pointers64 = pair->pointers64;
+				} else {
+					for (auto &channel : port.channels) port.pointers.push_back(channel.data());
+					for (auto &channel : port.channels64) port.pointers64.push_back(channel.data());
+				}
+				buffers.push_back({
+					.data32=using64 ? nullptr : port.pointers.data(),
+					.data64=using64 ? port.pointers64.data() : nullptr,
+					.channel_count=uint32_t(port.pointers.size()),
+					.latency=0,
+					.constant_mask=0
+				});
+			}
+		}
+
+		noteInputDialects = 0;
+		if (auto *notePorts = extension<clap_plugin_note_ports>(CLAP_EXT_NOTE_PORTS)) {
+			uint32_t count = notePorts->count(plugin, true);
+			for (uint32_t i = 0; i < count; ++i) {
+				clap_note_port_info info;
+				if (notePorts->get(plugin, i, true, &info)) noteInputDialects |= info.supported_dialects;
+			}
+		}
+	}
+
+	const clap_host host{
+		.clap_version=CLAP_VERSION,
+		.host_data=this,
+		.name="signalsmith-clap tools",
+		.vendor="Signalsmith Audio",
+		.url=nullptr,
+		.version="1.0.0",
+		.get_extension=[](const clap_host *, const char *) -> const void * {
+			return nullptr; // plugins have to cope without any host extensions
+		},
+		.request_restart=[](const clap_host *host) {
+			((HostedPlugin *)host->host_data)->restartRequested = true;
+		},
+		.request_process=[](const clap_host *host) {
+			((HostedPlugin *)host->host_data)->processRequested = true;
+		},
+		.request_callback=[](const clap_host *host) {
+			((HostedPlugin *)host->host_data)->callbackRequested = true;
+		}
+	};
+};
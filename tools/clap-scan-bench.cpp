@@ -0,0 +1,285 @@
+/* Host-scan and instantiation cost: how long a host waits while it loads the bundle, scans it, and builds a session.
+
+	clap-scan-bench [--clap path/to/plugins.clap] [--plugin id]... [--iterations 50] [--instances 200] [--sample-rate 48000] [--block-size 512] [--output report.json]
+
+For the entry, each iteration does `init()` (plus `dlopen()` with `--clap`), `get_factory()`, reads every descriptor, then `deinit()`.
+
+For each plugin, each iteration times `create_plugin()`, `init()`, `activate()`, `deactivate()` and `destroy()` on a fresh instance.  Then it builds a whole "project" of `--instances` instances at once, reporting the total time and the heap growth per instance (after `init()`, and again after `activate()`).  The heap is measured from the allocator's own stats, so it's only available on glibc and Mac.
+*/
+#include "./clap-host.h"
+#include "./json-writer.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+
+#if defined(__GLIBC__)
+#	include <malloc.h>
+#elif defined(__APPLE__)
+#	include <malloc/malloc.h>
+#endif
+
+struct Options {
+	std::string clapPath;
+	std::vector<std::string> pluginIds;
+	int iterations = 50, instances = 200;
+	double sampleRate = 48000;
+	uint32_t blockSize = 512;
+	std::string output;
+};
+
+static bool parseArgs(int argc, char **argv, Options &options) {
+	for (int i = 1; i < argc; ++i) {
+		std::string arg = argv[i];
+		if (i + 1 >= argc) {
+			std::fprintf(stderr, "missing value for %s\n", arg.c_str());
+			return false;
+		}
+		std::string value = argv[++i];
+		if (arg == "--clap") {
+			options.clapPath = value;
+		} else if (arg == "--plugin") {
+			options.pluginIds.push_back(value);
+		} else if (arg == "--iterations") {
+			options.iterations = std::max(1, std::atoi(value.c_str()));
+		} else if (arg == "--instances") {
+			options.instances = std::max(1, std::atoi(value.c_str()));
+		} else if (arg == "--sample-rate") {
+			options.sampleRate = std::strtod(value.c_str(), nullptr);
+		} else if (arg == "--block-size") {
+			options.blockSize = uint32_t(std::max(1, std::atoi(value.c_str())));
+		} else if (arg == "--output") {
+			options.output = value;
+		} else {
+			std::fprintf(stderr, "unknown option: %s\n", arg.c_str());
+			return false;
+		}
+	}
+	return true;
+}
+
+// Bytes currently allocated (including large `mmap()`ed blocks), or -1 if we can't tell
+static long long heapInUse() {
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+	auto info = mallinfo2();
+	return (long long)(info.uordblks + info.hblkhd);
+#elif defined(__GLIBC__)
+	auto info = mallinfo();
+	return (long long)(unsigned(info.uordblks)) + (long long)(unsigned(info.hblkhd));
+#elif defined(__APPLE__)
+	malloc_statistics_t stats;
+	malloc_zone_statistics(nullptr, &stats);
+	return (long long)stats.size_in_use;
+#else
+	return -1;
+#endif
+}
+
+using Clock = std::chrono::steady_clock;
+static double microsSince(Clock::time_point start) {
+	return std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+}
+
+// Collects one phase's timings, in microseconds
+struct Phase {
+	std::vector<double> micros;
+
+	template<class Fn>
+	auto time(Fn &&fn) -> decltype(fn()) {
+		auto start = Clock::now();
+		auto result = fn();
+		micros.push_back(microsSince(start));
+		return result;
+	}
+
+	void write(JsonWriter &json) {
+		json.openObject();
+		if (!micros.empty()) {
+			std::sort(micros.begin(), micros.end());
+			double sum = 0;
+			for (auto m : micros) sum += m;
+			json.field("minUs", micros.front());
+			json.field("medianUs", micros[micros.size()/2]);
+			json.field("meanUs", sum/micros.size());
+			json.field("maxUs", micros.back());
+		}
+		json.close();
+	}
+};
+
+// The plugins get no host extensions (the same as `HostedPlugin`)
+static const clap_host host{
+	.clap_version=CLAP_VERSION,
+	.host_data=nullptr,
+	.name="signalsmith-clap tools",
+	.vendor="Signalsmith Audio",
+	.url=nullptr,
+	.version="1.0.0",
+	.get_extension=[](const clap_host *, const char *) -> const void * {
+		return nullptr;
+	},
+	.request_restart=[](const clap_host *) {},
+	.request_process=[](const clap_host *) {},
+	.request_callback=[](const clap_host *) {}
+};
+
+static std::unique_ptr<PluginLibrary> loadLibrary(const Options &options) {
+	if (options.clapPath.empty()) return std::unique_ptr<PluginLibrary>(new PluginLibrary());
+	return std::unique_ptr<PluginLibrary>(new PluginLibrary(options.clapPath));
+}
+
+static void benchEntry(const Options &options, JsonWriter &json) {
+	Phase init, factory, descriptors, deinit;
+	for (int i = 0; i < options.iterations; ++i) {
+		auto library = init.time([&](){
+			return loadLibrary(options);
+		});
+		factory.time([&](){
+			return library->factory();
+		});
+		descriptors.time([&](){
+			return library->descriptors().size();
+		});
+		deinit.time([&](){
+			library.reset();
+			return 0;
+		});
+	}
+	json.key("entry").openObject();
+	json.key("init");
+	init.write(json);
+	json.key("getFactory");
+	factory.write(json);
+	json.key("descriptors");
+	descriptors.write(json);
+	json.key("deinit");
+	deinit.write(json);
+	json.close();
+}
+
+static void benchPlugin(const clap_plugin_factory *factory, const char *pluginId, const Options &options, JsonWriter &json) {
+	json.openObject();
+	json.field("plugin", pluginId);
+
+	Phase create, init, activate, deactivate, destroy;
+	for (int i = 0; i < options.iterations; ++i) {
+		auto *plugin = create.time([&](){
+			return factory->create_plugin(factory, &host, pluginId);
+		});
+		if (!plugin) {
+			json.field("error", "create_plugin() failed");
+			json.close();
+			return;
+		}
+		bool ok = init.time([&](){
+			return plugin->init(plugin);
+		});
+		ok = ok && activate.time([&](){
+			return plugin->activate(plugin, options.sampleRate, 1, options.blockSize);
+		});
+		if (ok) {
+			deactivate.time([&](){
+				plugin->deactivate(plugin);
+				return 0;
+			});
+		}
+		destroy.time([&](){
+			plugin->destroy(plugin);
+			return 0;
+		});
+		if (!ok) {
+			json.field("error", "init() or activate() failed");
+			json.close();
+			return;
+		}
+	}
+	json.key("create");
+	create.write(json);
+	json.key("init");
+	init.write(json);
+	json.key("activate");
+	activate.write(json);
+	json.key("deactivate");
+	deactivate.write(json);
+	json.key("destroy");
+	destroy.write(json);
+
+	// A whole project's worth at once
+	std::vector<const clap_plugin *> plugins;
+	plugins.reserve(size_t(options.instances));
+	long long heapBefore = heapInUse();
+	auto start = Clock::now();
+	for (int i = 0; i < options.instances; ++i) {
+		auto *plugin = factory->create_plugin(factory, &host, pluginId);
+		if (!plugin) break;
+		if (!plugin->init(plugin)) {
+			plugin->destroy(plugin);
+			break;
+		}
+		plugins.push_back(plugin);
+	}
+	double createMs = microsSince(start)*0.001;
+	long long heapCreated = heapInUse();
+	start = Clock::now();
+	for (auto *plugin : plugins) plugin->activate(plugin, options.sampleRate, 1, options.blockSize);
+	double activateMs = microsSince(start)*0.001;
+	long long heapActive = heapInUse();
+	start = Clock::now();
+	for (auto *plugin : plugins) {
+		plugin->deactivate(plugin);
+		plugin->destroy(plugin);
+	}
+	double teardownMs = microsSince(start)*0.001;
+
+	json.key("project").openObject();
+	json.field("instances", (unsigned long long)plugins.size());
+	json.field("createInitMs", createMs);
+	json.field("activateMs", activateMs);
+	json.field("teardownMs", teardownMs);
+	if (heapBefore >= 0 && !plugins.empty()) {
+		json.field("bytesPerInstance", (long long)((heapCreated - heapBefore)/(long long)plugins.size()));
+		json.field("bytesPerActiveInstance", (long long)((heapActive - heapBefore)/(long long)plugins.size()));
+	}
+	json.close();
+	json.close();
+}
+
+int main(int argc, char **argv) {
+	Options options;
+	if (!parseArgs(argc, argv, options)) return 1;
+
+	std::FILE *out = stdout;
+	if (!options.output.empty()) {
+		out = std::fopen(options.output.c_str(), "w");
+		if (!out) {
+			std::fprintf(stderr, "couldn't write %s\n", options.output.c_str());
+			return 1;
+		}
+	}
+
+	{
+		JsonWriter json{out};
+		json.openObject();
+		json.field("iterations", options.iterations);
+		json.field("instances", options.instances);
+		benchEntry(options, json);
+
+		auto library = loadLibrary(options);
+		auto *factory = library->factory();
+		if (!factory) {
+			std::fprintf(stderr, "couldn't load plugins: %s\n", library->error.c_str());
+			return 1;
+		}
+		json.key("plugins").openArray();
+		for (auto *descriptor : library->descriptors()) {
+			if (!options.pluginIds.empty() && std::find(options.pluginIds.begin(), options.pluginIds.end(), descriptor->id) == options.pluginIds.end()) continue;
+			benchPlugin(factory, descriptor->id, options, json);
+		}
+	}
+	if (out != stdout) std::fclose(out);
+	return 0;
+}
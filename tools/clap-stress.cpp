@@ -0,0 +1,380 @@
+/* Worst-case stress test for note-driven plugins: replays adversarial event patterns, and reports the tail latency (and deadline misses) for each one.
+
+	clap-stress [--clap path] [--plugin id]... [--scenario name]... [--sample-rate 48000] [--block-size 64,256] [--seconds 5] [--voices 512] [--chord-size 16] [--max-deadline-ratio 0.5] [--output report.json]
+
+Scenarios:
+	note-storm: fills all the voices, then a new chord every block, so every note steals a voice
+	mpe-flood: a note on each of 16 channels, with pressure and pitch-bend on every channel throughout each block
+	wildcard-release: a chord every block, released by a single wildcard note-off (or choke)
+	legato-chain: (monophonic, if there's a "polyphony" parameter) overlapping notes, so each one is a legato transition
+
+With `--max-deadline-ratio`, it exits with an error if any scenario's p99.9 block time is above that fraction of the block's duration.
+*/
+#include "./clap-host.h"
+#include "./event-generators.h"
+#include "./json-writer.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+struct Options {
+	std::string clapPath;
+	std::vector<std::string> pluginIds, scenarios;
+	double sampleRate = 48000;
+	std::vector<uint32_t> blockSizes{64, 256};
+	double seconds = 5;
+	int voices = 512, chordSize = 16;
+	double maxDeadlineRatio = 0; // 0 means no limit
+	unsigned seed = 1;
+	std::string output;
+};
+
+struct ScenarioContext {
+	HostedPlugin &hosted;
+	const Options &options;
+	uint32_t frames;
+	uint64_t blockIndex;
+	std::default_random_engine &random;
+	int32_t &nextNoteId;
+
+	uint32_t randomTime() {
+		return uint32_t(std::uniform_real_distribution<double>{0, 1}(random)*frames);
+	}
+	int16_t randomKey() {
+		return int16_t(std::uniform_int_distribution<int>{24, 108}(random));
+	}
+	void addSorted(std::vector<clap_event_note> &events) {
+		std::stable_sort(events.begin(), events.end(), [](auto &a, auto &b){
+			return a.header.time < b.header.time;
+		});
+		for (auto &e : events) hosted.eventsIn.add(e);
+	}
+};
+
+// Adds the events for each block
+using EventGenerator = std::function<void(ScenarioContext &context)>;
+
+struct Scenario {
+	const char *name;
+	// Returns a fresh generator for each run - or an empty one if the scenario doesn't apply to this plugin
+	std::function<EventGenerator(HostedPlugin &hosted, const Options &options)> start;
+};
+
+static clap_event_midi midiEvent(uint32_t time, uint8_t status, uint8_t data1, uint8_t data2) {
+	return {
+		.header={
+			.size=sizeof(clap_event_midi),
+			.time=time,
+			.space_id=CLAP_CORE_EVENT_SPACE_ID,
+			.type=CLAP_EVENT_MIDI,
+			.flags=0
+		},
+		.port_index=0,
+		.data={status, data1, data2}
+	};
+}
+
+// Finds a parameter by name, and sets it (with an event in the next block)
+static bool setParamByName(HostedPlugin &hosted, const char *name, double value) {
+	auto *params = hosted.extension<clap_plugin_params>(CLAP_EXT_PARAMS);
+	if (!params) return false;
+	uint32_t count = params->count(hosted.plugin);
+	for (uint32_t i = 0; i < count; ++i) {
+		clap_param_info info;
+		if (!params->get_info(hosted.plugin, i, &info) || std::string(info.name) != name) continue;
+		hosted.eventsIn.add(clap_event_param_value{
+			.header={
+				.size=sizeof(clap_event_param_value),
+				.time=0,
+				.space_id=CLAP_CORE_EVENT_SPACE_ID,
+				.type=CLAP_EVENT_PARAM_VALUE,
+				.flags=0
+			},
+			.param_id=info.id,
+			.cookie=info.cookie,
+			.note_id=-1,
+			.port_index=-1,
+			.channel=-1,
+			.key=-1,
+			.value=value
+		});
+		return true;
+	}
+	return false;
+}
+
+static std::vector<Scenario> allScenarios() {
+	std::vector<Scenario> scenarios;
+	scenarios.push_back({
+		"note-storm",
+		[](HostedPlugin &hosted, const Options &) -> EventGenerator {
+			if (!(hosted.noteInputDialects&CLAP_NOTE_DIALECT_CLAP)) return {};
+			return [](ScenarioContext &context) {
+				std::vector<clap_event_note> events;
+				// Fill all the voices (64 per block, so the first blocks aren't too silly), then chords which steal
+				int voices = context.options.voices;
+				int filled = int(context.blockIndex*64);
+				int count = (filled < voices) ? std::min(64, voices - filled) : context.options.chordSize;
+				for (int i = 0; i < count; ++i) {
+					int32_t noteId = context.nextNoteId++;
+					events.push_back(RandomNotes::noteEvent(CLAP_EVENT_NOTE_ON, context.randomTime(), context.randomKey(), noteId, 0.8, int16_t(noteId%16)));
+				}
+				context.addSorted(events);
+			};
+		}
+	});
+	scenarios.push_back({
+		"mpe-flood",
+		[](HostedPlugin &hosted, const Options &) -> EventGenerator {
+			if (!(hosted.noteInputDialects&(CLAP_NOTE_DIALECT_MIDI_MPE|CLAP_NOTE_DIALECT_MIDI))) return {};
+			return [](ScenarioContext &context) {
+				auto &events = context.hosted.eventsIn;
+				uint32_t frames = context.frames;
+				if (context.blockIndex == 0) {
+					for (uint8_t channel = 0; channel < 16; ++channel) {
+						events.add(midiEvent(0, 0x90|channel, uint8_t(context.randomKey()), 100));
+					}
+				}
+				// Pressure and pitch-bend on every channel, every 8 samples
+				for (uint32_t t = 0; t < frames; t += 8) {
+					for (uint8_t channel = 0; channel < 16; ++channel) {
+						double phase = double(context.hosted.steadyTime + t)/(channel + 100);
+						int bend = 0x2000 + int(0x1FFF*std::sin(phase));
+						events.add(midiEvent(t, 0xE0|channel, uint8_t(bend&0x7F), uint8_t(bend>>7)));
+						events.add(midiEvent(t, 0xD0|channel, uint8_t(64 + 63*std::cos(phase)), 0));
+					}
+				}
+			};
+		}
+	});
+	scenarios.push_back({
+		"wildcard-release",
+		[](HostedPlugin &hosted, const Options &) -> EventGenerator {
+			if (!(hosted.noteInputDialects&CLAP_NOTE_DIALECT_CLAP)) return {};
+			return [](ScenarioContext &context) {
+				std::vector<clap_event_note> events;
+				uint32_t releaseTime = context.frames/2;
+				for (int i = 0; i < context.options.chordSize; ++i) {
+					events.push_back(RandomNotes::noteEvent(CLAP_EVENT_NOTE_ON, context.randomTime()%(releaseTime + 1), context.randomKey(), context.nextNoteId++, 0.8, int16_t(i%16)));
+				}
+				// Alternate between a wildcard note-off and a wildcard choke
+				uint16_t type = (context.blockIndex%2) ? CLAP_EVENT_NOTE_CHOKE : CLAP_EVENT_NOTE_OFF;
+				auto release = RandomNotes::noteEvent(type, releaseTime, -1, -1, 0, -1);
+				release.port_index = -1;
+				events.push_back(release);
+				context.addSorted(events);
+			};
+		}
+	});
+	scenarios.push_back({
+		"legato-chain",
+		[](HostedPlugin &hosted, const Options &) -> EventGenerator {
+			if (!(hosted.noteInputDialects&CLAP_NOTE_DIALECT_CLAP)) return {};
+			setParamByName(hosted, "polyphony", 0); // monophonic, if the plugin has that
+			int32_t previousId = -1;
+			int16_t previousKey = -1;
+			return [=](ScenarioContext &context) mutable {
+				std::vector<clap_event_note> events;
+				// A new note every 32 samples, each released just after the next one starts
+				for (uint32_t t = 0; t < context.frames; t += 32) {
+					int32_t noteId = context.nextNoteId++;
+					int16_t key = context.randomKey();
+					events.push_back(RandomNotes::noteEvent(CLAP_EVENT_NOTE_ON, t, key, noteId, 0.8));
+					if (previousId >= 0) events.push_back(RandomNotes::noteEvent(CLAP_EVENT_NOTE_OFF, std::min(t + 1, context.frames - 1), previousKey, previousId, 0));
+					previousId = noteId;
+					previousKey = key;
+				}
+				context.addSorted(events);
+			};
+		}
+	});
+	return scenarios;
+}
+
+static bool parseArgs(int argc, char **argv, Options &options) {
+	for (int i = 1; i < argc; ++i) {
+		std::string arg = argv[i];
+		if (i + 1 >= argc) {
+			std::fprintf(stderr, "missing value for %s\n", arg.c_str());
+			return false;
+		}
+		std::string value = argv[++i];
+		if (arg == "--clap") {
+			options.clapPath = value;
+		} else if (arg == "--plugin") {
+			options.pluginIds.push_back(value);
+		} else if (arg == "--scenario") {
+			options.scenarios.push_back(value);
+		} else if (arg == "--sample-rate") {
+			options.sampleRate = std::strtod(value.c_str(), nullptr);
+		} else if (arg == "--block-size") {
+			options.blockSizes.clear();
+			size_t start = 0;
+			while (start < value.size()) {
+				size_t end = value.find(',', start);
+				if (end == std::string::npos) end = value.size();
+				options.blockSizes.push_back(uint32_t(std::strtoul(value.substr(start, end - start).c_str(), nullptr, 10)));
+				start = end + 1;
+			}
+		} else if (arg == "--seconds") {
+			options.seconds = std::strtod(value.c_str(), nullptr);
+		} else if (arg == "--voices") {
+			options.voices = std::atoi(value.c_str());
+		} else if (arg == "--chord-size") {
+			options.chordSize = std::atoi(value.c_str());
+		} else if (arg == "--max-deadline-ratio") {
+			options.maxDeadlineRatio = std::strtod(value.c_str(), nullptr);
+		} else if (arg == "--seed") {
+			options.seed = unsigned(std::strtoul(value.c_str(), nullptr, 10));
+		} else if (arg == "--output") {
+			options.output = value;
+		} else {
+			std::fprintf(stderr, "unknown option: %s\n", arg.c_str());
+			return false;
+		}
+	}
+	return true;
+}
+
+struct StressResult {
+	bool applicable = false, ok = false;
+	std::vector<double> blockNs; // sorted
+	uint64_t deadlineMisses = 0;
+	double deadlineNs = 0;
+
+	double percentile(double p) const {
+		if (blockNs.empty()) return 0;
+		size_t index = size_t(std::ceil(p*blockNs.size()));
+		return blockNs[std::min(blockNs.size() - 1, index ? index - 1 : 0)];
+	}
+};
+
+static void runScenario(const clap_plugin_factory *factory, const clap_plugin_descriptor *descriptor, const Scenario &scenario, uint32_t blockSize, const Options &options, StressResult &result) {
+	HostedPlugin hosted{factory, descriptor->id};
+	if (!hosted || !hosted.activate(options.sampleRate, blockSize)) return;
+	auto generator = scenario.start(hosted, options);
+	if (!generator) {
+		result.ok = true;
+		return;
+	}
+	result.applicable = true;
+	result.deadlineNs = blockSize*1e9/options.sampleRate;
+
+	std::default_random_engine random{options.seed};
+	int32_t nextNoteId = 0;
+	uint64_t blocks = uint64_t(std::ceil(options.seconds*options.sampleRate/blockSize));
+	result.blockNs.reserve(blocks);
+	for (uint64_t b = 0; b < blocks; ++b) {
+		fillNoise(hosted, blockSize, random);
+		ScenarioContext context{hosted, options, blockSize, b, random, nextNoteId};
+		generator(context);
+
+		auto start = std::chrono::steady_clock::now();
+		auto status = hosted.process(blockSize);
+		double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+		if (status == CLAP_PROCESS_ERROR) return;
+
+		result.blockNs.push_back(ns);
+		if (ns > result.deadlineNs) ++result.deadlineMisses;
+		hosted.eventsOut.clear();
+		hosted.mainThread();
+	}
+	std::sort(result.blockNs.begin(), result.blockNs.end());
+	result.ok = true;
+}
+
+int main(int argc, char **argv) {
+	Options options;
+	if (!parseArgs(argc, argv, options)) return 1;
+
+	std::unique_ptr<PluginLibrary> library;
+	if (options.clapPath.empty()) {
+		library.reset(new PluginLibrary());
+	} else {
+		library.reset(new PluginLibrary(options.clapPath));
+	}
+	auto *factory = library->factory();
+	if (!factory) {
+		std::fprintf(stderr, "couldn't load plugins: %s\n", library->error.c_str());
+		return 1;
+	}
+
+	std::vector<Scenario> scenarios;
+	for (auto &scenario : allScenarios()) {
+		bool wanted = options.scenarios.empty();
+		for (auto &name : options.scenarios) wanted = wanted || (name == scenario.name);
+		if (wanted) scenarios.push_back(scenario);
+	}
+	if (scenarios.empty()) {
+		std::fprintf(stderr, "no matching scenarios\n");
+		return 1;
+	}
+
+	std::FILE *out = stdout;
+	if (!options.output.empty()) {
+		out = std::fopen(options.output.c_str(), "w");
+		if (!out) {
+			std::fprintf(stderr, "couldn't write %s\n", options.output.c_str());
+			return 1;
+		}
+	}
+
+	bool allOk = true, withinLimits = true;
+	{
+		JsonWriter json{out};
+		json.openObject();
+		json.field("sampleRate", options.sampleRate);
+		json.field("seconds", options.seconds);
+		json.field("voices", options.voices);
+		json.field("chordSize", options.chordSize);
+		json.key("runs").openArray();
+		for (auto *descriptor : library->descriptors()) {
+			if (!options.pluginIds.empty()) {
+				bool found = false;
+				for (auto &id : options.pluginIds) found = found || (id == descriptor->id);
+				if (!found) continue;
+			}
+			for (auto &scenario : scenarios) {
+				for (uint32_t blockSize : options.blockSizes) {
+					StressResult result;
+					runScenario(factory, descriptor, scenario, blockSize, options, result);
+					allOk = allOk && result.ok;
+					if (!result.applicable) continue;
+
+					json.openObject();
+					json.field("plugin", descriptor->id);
+					json.field("scenario", scenario.name);
+					json.field("blockSize", blockSize);
+					json.field("ok", result.ok);
+					if (result.ok) {
+						double p999 = result.percentile(0.999);
+						json.field("blocks", (unsigned long long)result.blockNs.size());
+						json.field("deadlineNs", result.deadlineNs);
+						json.field("deadlineMisses", (unsigned long long)result.deadlineMisses);
+						json.key("blockNs").openObject();
+						json.field("p50", result.percentile(0.5));
+						json.field("p99", result.percentile(0.99));
+						json.field("p99.9", p999);
+						json.field("max", result.percentile(1));
+						json.close();
+						json.field("p99.9DeadlineRatio", p999/result.deadlineNs);
+						if (options.maxDeadlineRatio > 0 && p999 > options.maxDeadlineRatio*result.deadlineNs) {
+							withinLimits = false;
+							json.field("overLimit", true);
+						}
+					}
+					json.close();
+				}
+			}
+		}
+	}
+	if (out != stdout) std::fclose(out);
+	if (!allOk) return 2;
+	return withinLimits ? 0 : 3;
+}
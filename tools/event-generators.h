@@ -0,0 +1,137 @@
+#pragma once
+
+#include "clap/clap.h"
+
+#include "./clap-host.h"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+// Random notes: starts `notesPerSecond` on average, each held for a random length
+struct RandomNotes {
+	double notesPerSecond = 8;
+	double minSeconds = 0.05, maxSeconds = 1;
+	int16_t lowKey = 36, highKey = 96;
+
+	RandomNotes(unsigned seed=0) : random(seed) {}
+
+	// Adds events to `events` for the block from `blockStart` (in samples)
+	void addEvents(InputEventList &events, int64_t blockStart, uint32_t frames, double sampleRate) {
+		std::uniform_real_distribution<double> unit{0, 1};
+		// Note-offs which fall in this block, plus new notes - then sorted by time
+		std::vector<clap_event_note> newEvents;
+		for (size_t i = 0; i < held.size();) {
+			if (held[i].end < blockStart + frames) {
+				auto event = noteEvent(CLAP_EVENT_NOTE_OFF, uint32_t(std::max<int64_t>(held[i].end - blockStart, 0)), held[i].key, held[i].noteId, 0);
+				newEvents.push_back(event);
+				held[i] = held.back();
+				held.pop_back();
+			} else {
+				++i;
+			}
+		}
+		double expected = notesPerSecond*frames/sampleRate;
+		int count = std::poisson_distribution<int>{expected}(random);
+		for (int n = 0; n < count; ++n) {
+			uint32_t time = uint32_t(unit(random)*frames);
+			int16_t key = int16_t(lowKey + int(unit(random)*(highKey - lowKey)));
+			double velocity = 0.2 + 0.8*unit(random);
+			int32_t noteId = nextNoteId++;
+			newEvents.push_back(noteEvent(CLAP_EVENT_NOTE_ON, time, key, noteId, velocity));
+			double seconds = minSeconds + (maxSeconds - minSeconds)*unit(random);
+			held.push_back({blockStart + time + int64_t(seconds*sampleRate), key, noteId});
+		}
+		std::stable_sort(newEvents.begin(), newEvents.end(), [](auto &a, auto &b){
+			return a.header.time < b.header.time;
+		});
+		for (auto &e : newEvents) events.add(e);
+	}
+
+	static clap_event_note noteEvent(uint16_t type, uint32_t time, int16_t key, int32_t noteId, double velocity, int16_t channel=0) {
+		return {
+			.header={
+				.size=sizeof(clap_event_note),
+				.time=time,
+				.space_id=CLAP_CORE_EVENT_SPACE_ID,
+				.type=type,
+				.flags=0
+			},
+			.note_id=noteId,
+			.port_index=0,
+			.channel=channel,
+			.key=key,
+			.velocity=velocity
+		};
+	}
+
+private:
+	struct Held {
+		int64_t end;
+		int16_t key;
+		int32_t noteId;
+	};
+	std::vector<Held> held;
+	int32_t nextNoteId = 0;
+	std::default_random_engine random;
+};
+
+// Random parameter changes (across the whole range) for every automatable parameter
+struct RandomParams {
+	double changesPerSecond = 0;
+
+	RandomParams(const HostedPlugin &hosted, unsigned seed=0) : random(seed) {
+		if (auto *params = hosted.extension<clap_plugin_params>(CLAP_EXT_PARAMS)) {
+			uint32_t count = params->count(hosted.plugin);
+			for (uint32_t i = 0; i < count; ++i) {
+				clap_param_info info;
+				if (params->get_info(hosted.plugin, i, &info) && !(info.flags&CLAP_PARAM_IS_READONLY)) infos.push_back(info);
+			}
+		}
+	}
+
+	void addEvents(InputEventList &events, uint32_t frames, double sampleRate) {
+		if (infos.empty() || changesPerSecond <= 0) return;
+		std::uniform_real_distribution<double> unit{0, 1};
+		int count = std::poisson_distribution<int>{changesPerSecond*frames/sampleRate}(random);
+		std::vector<uint32_t> times;
+		for (int i = 0; i < count; ++i) times.push_back(uint32_t(unit(random)*frames));
+		std::sort(times.begin(), times.end());
+		for (auto time : times) {
+			auto &info = infos[size_t(unit(random)*infos.size())%infos.size()];
+			double value = info.min_value + (info.max_value - info.min_value)*unit(random);
+			if (info.flags&CLAP_PARAM_IS_STEPPED) value = std::round(value);
+			events.add(clap_event_param_value{
+				.header={
+					.size=sizeof(clap_event_param_value),
+					.time=time,
+					.space_id=CLAP_CORE_EVENT_SPACE_ID,
+					.type=CLAP_EVENT_PARAM_VALUE,
+					.flags=0
+				},
+				.param_id=info.id,
+				.cookie=info.cookie,
+				.note_id=-1,
+				.port_index=-1,
+				.channel=-1,
+				.key=-1,
+				.value=value
+			});
+		}
+	}
+
+private:
+	std::vector<clap_param_info> infos;
+	std::default_random_engine random;
+};
+
+// Fills every input channel with quiet noise
+inline void fillNoise(HostedPlugin &hosted, uint32_t frames, std::default_random_engine &random) {
+	std::uniform_real_distribution<float> dist{-0.25f, 0.25f};
+	for (auto &port : hosted.audioInputs) {
+		for (auto &channel : port.channels) {
+			for (uint32_t i = 0; i < frames; ++i) channel[i] = dist(random);
+		}
+	}
+}
@@ -0,0 +1,140 @@
+#pragma once
+
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+/* Just enough JSON output for the tools' reports.
+
+	JsonWriter json{file};
+	json.openObject();
+	json.key("runs").openArray();
+	...
+	json.close().close();
+*/
+struct JsonWriter {
+	JsonWriter(std::FILE *file) : file(file) {}
+	~JsonWriter() {
+		while (!stack.empty()) close();
+		std::fputc('\n', file);
+	}
+
+	JsonWriter & openObject() {
+		return open('{', '}');
+	}
+	JsonWriter & openArray() {
+		return open('[', ']');
+	}
+	JsonWriter & close() {
+		char closing = stack.back();
+		stack.pop_back();
+		newline();
+		std::fputc(closing, file);
+		first = false;
+		return *this;
+	}
+
+	JsonWriter & key(const std::string &k) {
+		separator();
+		string(k);
+		std::fputs(": ", file);
+		afterKey = true;
+		return *this;
+	}
+
+	JsonWriter & value(const std::string &v) {
+		separator();
+		string(v);
+		return *this;
+	}
+	JsonWriter & value(const char *v) {
+		if (!v) return null();
+		return value(std::string(v));
+	}
+	JsonWriter & value(double v) {
+		separator();
+		if (std::isfinite(v)) {
+			std::fprintf(file, "%.10g", v);
+		} else {
+			std::fputs("null", file);
+		}
+		return *this;
+	}
+	JsonWriter & value(int v) {
+		return value((long long)v);
+	}
+	JsonWriter & value(long long v) {
+		separator();
+		std::fprintf(file, "%lld", v);
+		return *this;
+	}
+	JsonWriter & value(unsigned long long v) {
+		separator();
+		std::fprintf(file, "%llu", v);
+		return *this;
+	}
+	JsonWriter & value(unsigned v) {
+		return value((unsigned long long)v);
+	}
+	JsonWriter & value(unsigned long v) {
+		return value((unsigned long long)v);
+	}
+	JsonWriter & value(bool v) {
+		separator();
+		std::fputs(v ? "true" : "false", file);
+		return *this;
+	}
+	JsonWriter & null() {
+		separator();
+		std::fputs("null", file);
+		return *this;
+	}
+
+	template<class V>
+	JsonWriter & field(const std::string &k, V &&v) {
+		return key(k).value(v);
+	}
+
+private:
+	std::FILE *file;
+	std::vector<char> stack;
+	bool first = true, afterKey = false;
+
+	JsonWriter & open(char opening, char closing) {
+		separator();
+		std::fputc(opening, file);
+		stack.push_back(closing);
+		first = true;
+		return *this;
+	}
+	void separator() {
+		if (afterKey) {
+			afterKey = false;
+			return;
+		}
+		if (!stack.empty()) {
+			if (!first) std::fputc(',', file);
+			newline();
+		}
+		first = false;
+	}
+	void newline() {
+		std::fputc('\n', file);
+		for (size_t i = 0; i < stack.size(); ++i) std::fputc('\t', file);
+	}
+	void string(const std::string &s) {
+		std::fputc('"', file);
+		for (unsigned char c : s) {
+			if (c == '"' || c == '\\') {
+				std::fputc('\\', file);
+				std::fputc(c, file);
+			} else if (c < 0x20) {
+				std::fprintf(file, "\\u%04x", c);
+			} else {
+				std::fputc(c, file);
+			}
+		}
+		std::fputc('"', file);
+	}
+};
@@ -0,0 +1,158 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+/* Reads a Standard MIDI File (format 0 or 1), merging the tracks into one list of channel messages timed in seconds (following any tempo changes).
+
+	MidiFile midi;
+	if (!midi.open(path)) ...
+	for (auto &event : midi.events) ... // sorted by time
+
+SysEx and meta events (apart from tempo) are skipped.
+*/
+struct MidiFile {
+	struct Event {
+		double seconds;
+		uint8_t bytes[3];
+	};
+	std::vector<Event> events;
+	double lengthSeconds = 0; // includes the end-of-track markers, not just the last event
+
+	bool open(const std::string &path) {
+		events.clear();
+		lengthSeconds = 0;
+		std::vector<uint8_t> data;
+		if (!readFile(path, data) || data.size() < 14) return false;
+		if (std::string(data.begin(), data.begin() + 4) != "MThd") return false;
+		size_t headerLength = u32(&data[4]);
+		uint16_t trackCount = u16(&data[10]);
+		uint16_t division = u16(&data[12]);
+
+		std::vector<TickEvent> tickEvents;
+		size_t pos = 8 + headerLength;
+		for (uint16_t track = 0; track < trackCount && pos + 8 <= data.size(); ++track) {
+			size_t length = u32(&data[pos + 4]);
+			bool isTrack = std::string(data.begin() + pos, data.begin() + pos + 4) == "MTrk";
+			pos += 8;
+			size_t end = std::min(pos + length, data.size());
+			if (isTrack && !readTrack(data, pos, end, tickEvents)) return false;
+			pos = end;
+		}
+		// Stable, so same-tick events stay in file order (and tempo changes land before notes on the same tick)
+		std::stable_sort(tickEvents.begin(), tickEvents.end(), [](const TickEvent &a, const TickEvent &b){
+			return a.tick < b.tick;
+		});
+
+		// Ticks -> seconds
+		double secondsPerTick;
+		bool smpte = division&0x8000;
+		if (smpte) {
+			int framesPerSecond = -int(int8_t(division>>8));
+			secondsPerTick = 1.0/(framesPerSecond*(division&0xFF));
+		} else {
+			secondsPerTick = 0.5/division; // 120bpm until we hear otherwise
+		}
+		uint64_t tick = 0;
+		double seconds = 0;
+		for (auto &e : tickEvents) {
+			seconds += (e.tick - tick)*secondsPerTick;
+			tick = e.tick;
+			if (e.tempo) {
+				if (!smpte) secondsPerTick = e.tempo*1e-6/division;
+			} else if (!e.endOfTrack) {
+				events.push_back({seconds, {e.bytes[0], e.bytes[1], e.bytes[2]}});
+			}
+			lengthSeconds = seconds;
+		}
+		return true;
+	}
+
+private:
+	struct TickEvent {
+		uint64_t tick;
+		uint32_t tempo = 0; // microseconds per quarter-note, if this is a tempo change
+		bool endOfTrack = false;
+		uint8_t bytes[3] = {0, 0, 0};
+	};
+
+	static bool readFile(const std::string &path, std::vector<uint8_t> &data) {
+		std::FILE *file = std::fopen(path.c_str(), "rb");
+		if (!file) return false;
+		uint8_t buffer[65536];
+		size_t count;
+		while ((count = std::fread(buffer, 1, sizeof(buffer), file)) > 0) data.insert(data.end(), buffer, buffer + count);
+		std::fclose(file);
+		return true;
+	}
+	static uint16_t u16(const uint8_t *b) {
+		return uint16_t((b[0]<<8) | b[1]);
+	}
+	static uint32_t u32(const uint8_t *b) {
+		return (uint32_t(b[0])<<24) | (uint32_t(b[1])<<16) | (uint32_t(b[2])<<8) | b[3];
+	}
+	static bool readVarInt(const std::vector<uint8_t> &data, size_t &pos, size_t end, uint32_t &value) {
+		value = 0;
+		for (int i = 0; i < 4; ++i) {
+			if (pos >= end) return false;
+			uint8_t b = data[pos++];
+			value = (value<<7) | (b&0x7F);
+			if (!(b&0x80)) return true;
+		}
+		return false;
+	}
+
+	static bool readTrack(const std::vector<uint8_t> &data, size_t pos, size_t end, std::vector<TickEvent> &tickEvents) {
+		uint64_t tick = 0;
+		uint8_t runningStatus = 0;
+		while (pos < end) {
+			uint32_t delta;
+			if (!readVarInt(data, pos, end, delta) || pos >= end) return false;
+			tick += delta;
+			TickEvent event{tick};
+
+			uint8_t status = data[pos];
+			if (status == 0xFF) { // meta
+				if (pos + 2 > end) return false;
+				uint8_t type = data[pos + 1];
+				pos += 2;
+				uint32_t length;
+				if (!readVarInt(data, pos, end, length) || pos + length > end) return false;
+				if (type == 0x51 && length == 3) {
+					event.tempo = (uint32_t(data[pos])<<16) | (uint32_t(data[pos + 1])<<8) | data[pos + 2];
+					tickEvents.push_back(event);
+				} else if (type == 0x2F) {
+					event.endOfTrack = true;
+					tickEvents.push_back(event);
+				}
+				pos += length;
+				continue;
+			} else if (status == 0xF0 || status == 0xF7) { // SysEx
+				++pos;
+				uint32_t length;
+				if (!readVarInt(data, pos, end, length) || pos + length > end) return false;
+				pos += length;
+				continue;
+			}
+
+			if (status >= 0xF0) return false; // not valid in a file
+			if (status&0x80) {
+				runningStatus = status;
+				++pos;
+			} else if (!runningStatus) {
+				return false;
+			}
+			size_t dataBytes = ((runningStatus&0xE0) == 0xC0) ? 1 : 2; // program change / channel pressure have one
+			if (pos + dataBytes > end) return false;
+			event.bytes[0] = runningStatus;
+			event.bytes[1] = data[pos];
+			if (dataBytes == 2) event.bytes[2] = data[pos + 1];
+			pos += dataBytes;
+			tickEvents.push_back(event);
+		}
+		return true;
+	}
+};
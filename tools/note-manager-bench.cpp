@@ -0,0 +1,397 @@
+/* Micro-benchmark for `NoteManager` on its own: each method, across polyphony and input dialect, reported as JSON.
+
+	note-manager-bench [--polyphony 8,64,1024] [--dialect clap,midi1,mpe] [--block-size 256] [--events-per-block 32] [--min-calls 100000] [--output report.json]
+
+For each dialect/polyphony it times:
+	processEvent: a mixed stream (note-ons, note-offs and modulation, with the voices kept full) - ns/event, and ns/block including `.processTo()` and stopping released notes
+	start, modNotes, release, stop: filling every voice, modulating each one, then releasing and stopping them all
+	startSteal, legato: starting notes when every voice is already in use, or as legato transitions
+	processTo: a whole block with every voice active
+
+The `would*()` translation is included in the timings, since that's where the dialects differ.
+*/
+#include "./clap-host.h"
+#include "./json-writer.h"
+
+#include "signalsmith-clap/note-manager.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <random>
+#include <string>
+#include <vector>
+
+using NoteManager = signalsmith::clap::NoteManager;
+
+struct Options {
+	std::vector<size_t> polyphonies{8, 16, 32, 64, 128, 256, 512, 1024};
+	std::vector<std::string> dialects{"clap", "midi1", "mpe"};
+	uint32_t blockSize = 256, eventsPerBlock = 32;
+	size_t minCalls = 100000;
+	std::string output;
+};
+
+static std::vector<std::string> splitList(const std::string &str) {
+	std::vector<std::string> result;
+	size_t start = 0;
+	while (start <= str.size()) {
+		size_t end = str.find(',', start);
+		if (end == std::string::npos) end = str.size();
+		if (end > start) result.push_back(str.substr(start, end - start));
+		start = end + 1;
+	}
+	return result;
+}
+
+static bool parseArgs(int argc, char **argv, Options &options) {
+	for (int i = 1; i < argc; ++i) {
+		std::string arg = argv[i];
+		if (i + 1 >= argc) {
+			std::fprintf(stderr, "missing value for %s\n", arg.c_str());
+			return false;
+		}
+		std::string value = argv[++i];
+		if (arg == "--polyphony") {
+			options.polyphonies.clear();
+			for (auto &v : splitList(value)) options.polyphonies.push_back(std::strtoul(v.c_str(), nullptr, 10));
+		} else if (arg == "--dialect") {
+			options.dialects = splitList(value);
+		} else if (arg == "--block-size") {
+			options.blockSize = uint32_t(std::strtoul(value.c_str(), nullptr, 10));
+		} else if (arg == "--events-per-block") {
+			options.eventsPerBlock = uint32_t(std::strtoul(value.c_str(), nullptr, 10));
+		} else if (arg == "--min-calls") {
+			options.minCalls = std::strtoul(value.c_str(), nullptr, 10);
+		} else if (arg == "--output") {
+			options.output = value;
+		} else {
+			std::fprintf(stderr, "unknown option: %s\n", arg.c_str());
+			return false;
+		}
+	}
+	return true;
+}
+
+// Makes the events for note `i` in a particular dialect - every index is a distinct note (port/channel/key, as well as note ID for CLAP), moving on to the next port once a port's channels/keys are used up
+struct Dialect {
+	enum Type {clap, midi1, mpe};
+	Type type;
+
+	static bool fromName(const std::string &name, Dialect &dialect) {
+		if (name == "clap") {
+			dialect.type = clap;
+		} else if (name == "midi1") {
+			dialect.type = midi1;
+		} else if (name == "mpe") {
+			dialect.type = mpe;
+		} else {
+			return false;
+		}
+		return true;
+	}
+
+	void noteOn(InputEventList &events, size_t i, uint32_t time) const {
+		if (type == clap) {
+			events.add(noteEvent(CLAP_EVENT_NOTE_ON, i, time, 0.8));
+		} else {
+			events.add(midiEvent(time, port(i), 0x90|channel(i), key(i), 100));
+		}
+	}
+	void noteOff(InputEventList &events, size_t i, uint32_t time) const {
+		if (type == clap) {
+			events.add(noteEvent(CLAP_EVENT_NOTE_OFF, i, time, 0));
+		} else {
+			events.add(midiEvent(time, port(i), 0x80|channel(i), key(i), 0));
+		}
+	}
+	// Per-note tuning for CLAP, pitch-wheel (for the whole channel) for MIDI, alternating pitch-wheel and pressure for MPE
+	void mod(InputEventList &events, size_t i, uint32_t time, double unit) const {
+		if (type == clap) {
+			events.add(clap_event_note_expression{
+				.header={
+					.size=sizeof(clap_event_note_expression),
+					.time=time,
+					.space_id=CLAP_CORE_EVENT_SPACE_ID,
+					.type=CLAP_EVENT_NOTE_EXPRESSION,
+					.flags=0
+				},
+				.expression_id=CLAP_NOTE_EXPRESSION_TUNING,
+				.note_id=int32_t(i),
+				.port_index=int16_t(port(i)),
+				.channel=int16_t(channel(i)),
+				.key=int16_t(key(i)),
+				.value=unit*2 - 1
+			});
+		} else if (type == mpe && (i%2)) {
+			events.add(midiEvent(time, port(i), 0xD0|channel(i), uint8_t(unit*127), 0));
+		} else {
+			int bend = int(unit*0x3FFF);
+			events.add(midiEvent(time, port(i), 0xE0|channel(i), uint8_t(bend&0x7F), uint8_t(bend>>7)));
+		}
+	}
+
+private:
+	// 96 keys (from 24) on each channel: 16 channels for CLAP/MIDI1, and the 15 member channels for MPE
+	size_t channelsPerPort() const {
+		return (type == mpe) ? 15 : 16;
+	}
+	uint16_t port(size_t i) const {
+		return uint16_t(i/(96*channelsPerPort()));
+	}
+	uint8_t channel(size_t i) const {
+		if (type == clap) return uint8_t(i%16);
+		if (type == midi1) return uint8_t((i/96)%16); // mostly channel 0, like a normal keyboard
+		return uint8_t(1 + i%15); // MPE: a channel per note (until there are more than 15)
+	}
+	uint8_t key(size_t i) const {
+		if (type == midi1) return uint8_t(24 + i%96);
+		return uint8_t(24 + (i/channelsPerPort())%96);
+	}
+
+	clap_event_note noteEvent(uint16_t eventType, size_t i, uint32_t time, double velocity) const {
+		return {
+			.header={
+				.size=sizeof(clap_event_note),
+				.time=time,
+				.space_id=CLAP_CORE_EVENT_SPACE_ID,
+				.type=eventType,
+				.flags=0
+			},
+			.note_id=int32_t(i),
+			.port_index=int16_t(port(i)),
+			.channel=int16_t(channel(i)),
+			.key=int16_t(key(i)),
+			.velocity=velocity
+		};
+	}
+	static clap_event_midi midiEvent(uint32_t time, uint16_t port, uint8_t status, uint8_t data1, uint8_t data2) {
+		return {
+			.header={
+				.size=sizeof(clap_event_midi),
+				.time=time,
+				.space_id=CLAP_CORE_EVENT_SPACE_ID,
+				.type=CLAP_EVENT_MIDI,
+				.flags=0
+			},
+			.port_index=port,
+			.data={status, data1, data2}
+		};
+	}
+};
+
+// Accumulates time across many short sections
+struct Timer {
+	double ns = 0;
+	uint64_t calls = 0;
+
+	template<class Fn>
+	void time(uint64_t count, Fn &&fn) {
+		auto start = std::chrono::steady_clock::now();
+		fn();
+		ns += std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+		calls += count;
+	}
+	double perCall() const {
+		return calls ? ns/calls : 0;
+	}
+};
+
+struct RunResult {
+	Timer start, startSteal, modNotes, legato, release, stop, processTo;
+	Timer streamEvents, streamBlocks;
+	uint64_t tasks = 0; // also stops the work being optimised out
+};
+
+static void runMethods(const Dialect &dialect, size_t polyphony, const Options &options, RunResult &result) {
+	NoteManager manager{polyphony};
+	OutputEventList eventsOut;
+	InputEventList ons, offs, mods, extraOns, legatoOns;
+	for (size_t i = 0; i < polyphony; ++i) {
+		dialect.noteOn(ons, i, 0);
+		dialect.noteOff(offs, i, uint32_t(i%options.blockSize));
+		dialect.mod(mods, i, uint32_t(i%options.blockSize), double(i%8)/8);
+		dialect.noteOn(extraOns, polyphony + i, 0);
+		dialect.noteOn(legatoOns, polyphony*2 + i, uint32_t(i%options.blockSize));
+	}
+	auto startAll = [&](const InputEventList &events) {
+		for (size_t e = 0; e < events.size(); ++e) {
+			auto note = manager.wouldStart(events.get(e));
+			if (note) result.tasks += manager.start(*note, eventsOut.list()).size();
+		}
+	};
+
+	size_t iterations = (options.minCalls + polyphony - 1)/polyphony;
+	std::vector<NoteManager::Note> existing;
+	for (size_t iteration = 0; iteration < iterations; ++iteration) {
+		// Fill, modulate, process, release and stop
+		manager.reset();
+		manager.startBlock();
+		result.start.time(polyphony, [&](){
+			startAll(ons);
+		});
+		result.modNotes.time(polyphony, [&](){
+			for (size_t e = 0; e < mods.size(); ++e) {
+				auto noteMod = manager.wouldModNotes(mods.get(e));
+				if (noteMod) result.tasks += manager.modNotes(*noteMod).size();
+			}
+		});
+		result.processTo.time(1, [&](){
+			manager.startBlock();
+			result.tasks += manager.processTo(options.blockSize).size();
+		});
+		manager.startBlock();
+		result.release.time(polyphony, [&](){
+			for (size_t e = 0; e < offs.size(); ++e) {
+				auto note = manager.wouldRelease(offs.get(e));
+				if (note) result.tasks += manager.release(*note).size();
+			}
+		});
+		existing = manager.activeNotes();
+		result.stop.time(existing.size(), [&](){
+			for (auto &note : existing) manager.stop(note, eventsOut.list());
+		});
+
+		// Full voices, then steal all of them, then legato every one
+		manager.reset();
+		manager.startBlock();
+		startAll(ons);
+		result.startSteal.time(polyphony, [&](){
+			startAll(extraOns);
+		});
+		existing = manager.activeNotes();
+		result.legato.time(polyphony, [&](){
+			for (size_t e = 0; e < legatoOns.size(); ++e) {
+				auto note = manager.wouldStart(legatoOns.get(e));
+				if (note) result.tasks += manager.legato(*note, existing[e], eventsOut.list()).size();
+			}
+		});
+		eventsOut.clear();
+	}
+}
+
+// A steady stream of note-ons, note-offs (oldest first) and modulation, as a synth would handle it
+static void runStream(const Dialect &dialect, size_t polyphony, const Options &options, RunResult &result) {
+	NoteManager manager{polyphony};
+	OutputEventList eventsOut;
+	InputEventList events;
+	std::default_random_engine random{1};
+	std::deque<size_t> held;
+	size_t nextIndex = 0;
+
+	auto processBlock = [&](){
+		manager.startBlock();
+		for (size_t e = 0; e < events.size(); ++e) {
+			// Stolen notes (`stateKill`) are already stopped by `.start()`
+			result.tasks += manager.processEvent(events.get(e), eventsOut.list()).size();
+		}
+	};
+	auto finishBlock = [&](){
+		for (auto &task : manager.processTo(options.blockSize)) {
+			// Released notes stop immediately
+			if (task.state == NoteManager::stateUp || task.state == NoteManager::stateRelease) manager.stop(task, eventsOut.list());
+		}
+	};
+
+	// Fill the voices first (untimed)
+	for (size_t i = 0; i < polyphony; ++i) {
+		dialect.noteOn(events, nextIndex, 0);
+		held.push_back(nextIndex++);
+	}
+	processBlock();
+	finishBlock();
+	events.clear();
+
+	uint32_t eventsPerBlock = std::max<uint32_t>(options.eventsPerBlock, 1);
+	size_t blocks = (options.minCalls + eventsPerBlock - 1)/eventsPerBlock;
+	for (size_t b = 0; b < blocks; ++b) {
+		for (uint32_t k = 0; k < eventsPerBlock; ++k) {
+			uint32_t time = uint32_t(uint64_t(k)*options.blockSize/eventsPerBlock);
+			// on, mod, mod, off, ...
+			if (k%4 == 0 || held.empty()) {
+				dialect.noteOn(events, nextIndex%1024, time);
+				held.push_back(nextIndex++%1024);
+				if (held.size() > polyphony) held.pop_front(); // stolen
+			} else if (k%4 == 3) {
+				dialect.noteOff(events, held.front(), time);
+				held.pop_front();
+			} else {
+				size_t i = held[std::uniform_int_distribution<size_t>{0, held.size() - 1}(random)];
+				dialect.mod(events, i, time, std::uniform_real_distribution<double>{0, 1}(random));
+			}
+		}
+
+		auto blockStart = std::chrono::steady_clock::now();
+		result.streamEvents.time(events.size(), processBlock);
+		finishBlock();
+		result.streamBlocks.ns += std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - blockStart).count();
+		++result.streamBlocks.calls;
+		result.tasks += manager.activeNotes().size();
+
+		events.clear();
+		eventsOut.clear();
+	}
+}
+
+int main(int argc, char **argv) {
+	Options options;
+	if (!parseArgs(argc, argv, options)) return 1;
+
+	std::vector<std::pair<std::string, Dialect>> dialects;
+	for (auto &name : options.dialects) {
+		Dialect dialect;
+		if (!Dialect::fromName(name, dialect)) {
+			std::fprintf(stderr, "unknown dialect: %s\n", name.c_str());
+			return 1;
+		}
+		dialects.push_back({name, dialect});
+	}
+
+	std::FILE *out = stdout;
+	if (!options.output.empty()) {
+		out = std::fopen(options.output.c_str(), "w");
+		if (!out) {
+			std::fprintf(stderr, "couldn't write %s\n", options.output.c_str());
+			return 1;
+		}
+	}
+	{
+		JsonWriter json{out};
+		json.openObject();
+		json.field("blockSize", options.blockSize);
+		json.field("eventsPerBlock", options.eventsPerBlock);
+		json.key("runs").openArray();
+		for (auto &pair : dialects) {
+			for (size_t polyphony : options.polyphonies) {
+				if (!polyphony) continue;
+				RunResult result;
+				runMethods(pair.second, polyphony, options, result);
+				runStream(pair.second, polyphony, options, result);
+
+				json.openObject();
+				json.field("dialect", pair.first);
+				json.field("polyphony", (unsigned long long)polyphony);
+				json.key("processEvent").openObject();
+				json.field("events", (unsigned long long)result.streamEvents.calls);
+				json.field("nsPerEvent", result.streamEvents.perCall());
+				json.field("nsPerBlock", result.streamBlocks.perCall());
+				json.close();
+				json.key("nsPerCall").openObject();
+				json.field("start", result.start.perCall());
+				json.field("startSteal", result.startSteal.perCall());
+				json.field("modNotes", result.modNotes.perCall());
+				json.field("legato", result.legato.perCall());
+				json.field("release", result.release.perCall());
+				json.field("stop", result.stop.perCall());
+				json.close();
+				json.field("processToNsPerBlock", result.processTo.perCall());
+				json.field("tasks", (unsigned long long)result.tasks);
+				json.close();
+			}
+		}
+	}
+	if (out != stdout) std::fclose(out);
+	return 0;
+}
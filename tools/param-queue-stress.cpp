@@ -0,0 +1,155 @@
+/* Stress test for `Param`'s UI queue: one thread makes UI edits as fast as it can, while another sends them on as the audio thread, stalling now and then so the queue overflows.
+
+	param-queue-stress [--seconds 2] [--seed 1]
+
+UI values are an increasing counter, so it checks that the host:
+	* only ever sees values go up (nothing stale arrives after something newer)
+	* ends up on the last value the UI set
+	* sees gestures which alternate begin/end, and are all closed at the end
+
+It exits with an error if any of these fail.
+*/
+#include "signalsmith-clap/params.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+using Param = signalsmith::clap::Param;
+
+struct Options {
+	double seconds = 2;
+	unsigned seed = 1;
+};
+
+static bool parseArgs(int argc, char **argv, Options &options) {
+	for (int i = 1; i < argc; ++i) {
+		std::string arg = argv[i];
+		if (i + 1 >= argc) {
+			std::fprintf(stderr, "missing value for %s\n", arg.c_str());
+			return false;
+		}
+		std::string value = argv[++i];
+		if (arg == "--seconds") {
+			options.seconds = std::strtod(value.c_str(), nullptr);
+		} else if (arg == "--seed") {
+			options.seed = unsigned(std::atoi(value.c_str()));
+		} else {
+			std::fprintf(stderr, "unknown option: %s\n", arg.c_str());
+			return false;
+		}
+	}
+	return true;
+}
+
+// What the host sees, checked as it arrives
+struct HostCheck {
+	double lastValue = 0;
+	bool inGesture = false;
+	uint64_t values = 0, gestures = 0, errors = 0;
+
+	const clap_output_events * list() const {
+		return &clapList;
+	}
+
+	void check(const clap_event_header *header) {
+		if (header->type == CLAP_EVENT_PARAM_VALUE) {
+			double v = ((const clap_event_param_value *)header)->value;
+			if (v < lastValue) fail("value went backwards", v);
+			lastValue = v;
+			++values;
+		} else if (header->type == CLAP_EVENT_PARAM_GESTURE_BEGIN) {
+			if (inGesture) fail("gesture begin inside a gesture", lastValue);
+			inGesture = true;
+			++gestures;
+		} else if (header->type == CLAP_EVENT_PARAM_GESTURE_END) {
+			if (!inGesture) fail("gesture end outside a gesture", lastValue);
+			inGesture = false;
+		}
+	}
+
+private:
+	void fail(const char *message, double value) {
+		if (errors++ < 10) std::fprintf(stderr, "%s (at value %.0f)\n", message, value);
+	}
+
+	const clap_output_events clapList{
+		.ctx=this,
+		.try_push=[](const clap_output_events *list, const clap_event_header *event) -> bool {
+			((HostCheck *)list->ctx)->check(event);
+			return true;
+		}
+	};
+};
+
+int main(int argc, char **argv) {
+	Options options;
+	if (!parseArgs(argc, argv, options)) return 1;
+
+	Param param{"stress", "Stress", 0x5EE5, 0, 0, 1e12};
+	HostCheck host;
+	std::atomic<bool> running{true};
+	uint64_t overflowBlocks = 0;
+
+	std::thread audioThread([&](){
+		std::mt19937 random(options.seed + 1);
+		while (running.load()) {
+			param.sendEvents(host.list());
+			// Mostly quick blocks, with an occasional stall long enough to fill the queue
+			if (random()%64 == 0) {
+				++overflowBlocks;
+				std::this_thread::sleep_for(std::chrono::milliseconds(2));
+			} else {
+				std::this_thread::yield();
+			}
+		}
+		param.sendEvents(host.list());
+	});
+
+	std::mt19937 random(options.seed);
+	double uiValue = 0;
+	uint64_t uiEdits = 0;
+	bool uiGesture = false;
+	auto end = std::chrono::steady_clock::now() + std::chrono::duration<double>(options.seconds);
+	while (std::chrono::steady_clock::now() < end) {
+		for (int i = 0; i < 100; ++i) {
+			switch (random()%8) {
+				case 0:
+					if (!uiGesture) param.uiGestureStart();
+					uiGesture = true;
+					break;
+				case 1:
+					if (uiGesture) param.uiGestureEnd();
+					uiGesture = false;
+					break;
+				default:
+					param.uiValue(++uiValue);
+					++uiEdits;
+			}
+		}
+		if (random()%16 == 0) std::this_thread::yield();
+	}
+	if (uiGesture) param.uiGestureEnd();
+	running = false;
+	audioThread.join();
+
+	if (host.lastValue != uiValue) {
+		std::fprintf(stderr, "host ended on %.0f, but the UI's last value was %.0f\n", host.lastValue, uiValue);
+		++host.errors;
+	}
+	if (param.value.load() != uiValue) {
+		std::fprintf(stderr, "parameter ended on %.0f, but the UI's last value was %.0f\n", param.value.load(), uiValue);
+		++host.errors;
+	}
+	if (host.inGesture) {
+		std::fprintf(stderr, "gesture left open\n");
+		++host.errors;
+	}
+	std::printf("%llu UI edits, %llu values and %llu gestures sent, %llu stalled blocks: %s\n", (unsigned long long)uiEdits, (unsigned long long)host.values, (unsigned long long)host.gestures, (unsigned long long)overflowBlocks, host.errors ? "FAILED" : "ok");
+	return host.errors ? 1 : 0;
+}
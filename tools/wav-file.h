@@ -0,0 +1,252 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+#if defined(_WIN32)
+#	define WIN32_LEAN_AND_MEAN
+#	include <windows.h>
+#else
+#	include <fcntl.h>
+#	include <sys/mman.h>
+#	include <sys/stat.h>
+#	include <unistd.h>
+#endif
+
+// A whole file, memory-mapped: either an existing one (read-only), or a new one of a fixed size (read/write)
+struct MappedFile {
+	MappedFile() {}
+	~MappedFile() {
+		close();
+	}
+	MappedFile(const MappedFile &other) = delete;
+
+	bool openRead(const std::string &path) {
+		close();
+#if defined(_WIN32)
+		file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (file == INVALID_HANDLE_VALUE) return false;
+		LARGE_INTEGER fileSize;
+		if (!GetFileSizeEx(file, &fileSize)) return false;
+		return map(size_t(fileSize.QuadPart), false);
+#else
+		fd = ::open(path.c_str(), O_RDONLY);
+		if (fd < 0) return false;
+		struct stat info;
+		if (fstat(fd, &info) != 0) return false;
+		return map(size_t(info.st_size), false);
+#endif
+	}
+	bool create(const std::string &path, size_t bytes) {
+		close();
+#if defined(_WIN32)
+		file = CreateFileA(path.c_str(), GENERIC_READ|GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (file == INVALID_HANDLE_VALUE) return false;
+#else
+		fd = ::open(path.c_str(), O_RDWR|O_CREAT|O_TRUNC, 0644);
+		if (fd < 0 || ftruncate(fd, off_t(bytes)) != 0) return false;
+#endif
+		return map(bytes, true);
+	}
+	void close() {
+#if defined(_WIN32)
+		if (data) UnmapViewOfFile(data);
+		if (mapping) CloseHandle(mapping);
+		if (file != INVALID_HANDLE_VALUE) CloseHandle(file);
+		mapping = nullptr;
+		file = INVALID_HANDLE_VALUE;
+#else
+		if (data) munmap(data, size);
+		if (fd >= 0) ::close(fd);
+		fd = -1;
+#endif
+		data = nullptr;
+		size = 0;
+	}
+
+	unsigned char *data = nullptr;
+	size_t size = 0;
+
+private:
+#if defined(_WIN32)
+	HANDLE file = INVALID_HANDLE_VALUE, mapping = nullptr;
+
+	bool map(size_t bytes, bool writable) {
+		size = bytes;
+		if (!bytes) return true;
+		mapping = CreateFileMappingA(file, nullptr, writable ? PAGE_READWRITE : PAGE_READONLY, DWORD(uint64_t(bytes)>>32), DWORD(bytes), nullptr);
+		if (!mapping) return false;
+		data = (unsigned char *)MapViewOfFile(mapping, writable ? FILE_MAP_WRITE : FILE_MAP_READ, 0, 0, bytes);
+		return data;
+	}
+#else
+	int fd = -1;
+
+	bool map(size_t bytes, bool writable) {
+		size = bytes;
+		if (!bytes) return true;
+		void *ptr = mmap(nullptr, bytes, writable ? (PROT_READ|PROT_WRITE) : PROT_READ, MAP_SHARED, fd, 0);
+		if (ptr == MAP_FAILED) return false;
+		data = (unsigned char *)ptr;
+		// We read/write front-to-back
+		madvise(ptr, bytes, MADV_SEQUENTIAL);
+		return true;
+	}
+#endif
+};
+
+/* Reads a WAV file (16/24/32-bit int or 32/64-bit float) through a memory map, converting to `float` a block at a time.
+
+	WavIn wav;
+	if (!wav.open(path)) ...
+	wav.read(start, frames, channelPointers, channelCount); // missing channels are filled with zeros
+*/
+struct WavIn {
+	uint32_t channels = 0, sampleRate = 0, bitsPerSample = 0;
+	bool isFloat = false;
+	uint64_t frames = 0;
+
+	bool open(const std::string &path) {
+		if (!file.openRead(path) || file.size < 12) return false;
+		auto *bytes = file.data;
+		if (std::memcmp(bytes, "RIFF", 4) || std::memcmp(bytes + 8, "WAVE", 4)) return false;
+		size_t pos = 12;
+		bool hasFormat = false;
+		while (pos + 8 <= file.size) {
+			uint32_t chunkSize = u32(bytes + pos + 4);
+			const unsigned char *chunk = bytes + pos + 8;
+			size_t available = std::min<size_t>(chunkSize, file.size - (pos + 8));
+			if (!std::memcmp(bytes + pos, "fmt ", 4) && chunkSize >= 16) {
+				if (available < chunkSize) return false; // truncated format chunk
+				uint16_t format = u16(chunk);
+				channels = u16(chunk + 2);
+				sampleRate = u32(chunk + 4);
+				bitsPerSample = u16(chunk + 14);
+				if (format == 0xFFFE && chunkSize >= 26) format = u16(chunk + 24); // WAVE_FORMAT_EXTENSIBLE: the sub-format's first two bytes
+				isFloat = (format == 3);
+				if (format != 1 && format != 3) return false;
+				hasFormat = true;
+			} else if (!std::memcmp(bytes + pos, "data", 4) && hasFormat) {
+				samples = chunk;
+				// Truncated files (or streamed ones with a placeholder size) just get what's there
+				frameBytes = channels*(bitsPerSample/8);
+				if (!frameBytes) return false;
+				frames = available/frameBytes;
+				return supported();
+			}
+			pos += 8 + chunkSize + (chunkSize&1);
+		}
+		return false;
+	}
+
+	void read(uint64_t start, uint32_t count, float **outputs, uint32_t outputChannels) const {
+		for (uint32_t c = 0; c < outputChannels; ++c) {
+			float *output = outputs[c];
+			if (c >= channels || start >= frames) {
+				std::fill(output, output + count, 0.0f);
+				continue;
+			}
+			uint32_t available = uint32_t(std::min<uint64_t>(count, frames - start));
+			size_t sampleBytes = bitsPerSample/8;
+			const unsigned char *in = samples + start*frameBytes + c*sampleBytes;
+			for (uint32_t i = 0; i < available; ++i) {
+				output[i] = sample(in);
+				in += frameBytes;
+			}
+			std::fill(output + available, output + count, 0.0f);
+		}
+	}
+
+private:
+	MappedFile file;
+	const unsigned char *samples = nullptr;
+	size_t frameBytes = 0;
+
+	static uint16_t u16(const unsigned char *b) {
+		return uint16_t(b[0] | (b[1]<<8));
+	}
+	static uint32_t u32(const unsigned char *b) {
+		return uint32_t(b[0]) | (uint32_t(b[1])<<8) | (uint32_t(b[2])<<16) | (uint32_t(b[3])<<24);
+	}
+
+	bool supported() const {
+		if (isFloat) return bitsPerSample == 32 || bitsPerSample == 64;
+		return bitsPerSample == 16 || bitsPerSample == 24 || bitsPerSample == 32;
+	}
+	float sample(const unsigned char *b) const {
+		if (isFloat) {
+			if (bitsPerSample == 32) {
+				float f;
+				std::memcpy(&f, b, 4);
+				return f;
+			}
+			double d;
+			std::memcpy(&d, b, 8);
+			return float(d);
+		}
+		if (bitsPerSample == 16) return int16_t(u16(b))*(1.0f/32768);
+		if (bitsPerSample == 24) return int32_t((uint32_t(b[0])<<8) | (uint32_t(b[1])<<16) | (uint32_t(b[2])<<24))*(1.0f/2147483648.0f);
+		return int32_t(u32(b))*(1.0f/2147483648.0f);
+	}
+};
+
+/* Writes a 32-bit float WAV of a known length, straight into a memory-mapped file.
+
+	WavOut wav;
+	if (!wav.create(path, channels, sampleRate, frames)) ...
+	wav.write(start, frames, channelPointers);
+*/
+struct WavOut {
+	uint32_t channels = 0;
+	uint64_t frames = 0;
+
+	bool create(const std::string &path, uint32_t channels, uint32_t sampleRate, uint64_t frames) {
+		this->channels = channels;
+		this->frames = frames;
+		uint64_t dataBytes = frames*channels*4;
+		if (!file.create(path, size_t(44 + dataBytes)) || !file.data) return false;
+		auto *b = file.data;
+		std::memcpy(b, "RIFF", 4);
+		put32(b + 4, uint32_t(36 + dataBytes));
+		std::memcpy(b + 8, "WAVEfmt ", 8);
+		put32(b + 16, 16);
+		put16(b + 20, 3); // float
+		put16(b + 22, uint16_t(channels));
+		put32(b + 24, sampleRate);
+		put32(b + 28, sampleRate*channels*4);
+		put16(b + 32, uint16_t(channels*4));
+		put16(b + 34, 32);
+		std::memcpy(b + 36, "data", 4);
+		put32(b + 40, uint32_t(dataBytes));
+		return true;
+	}
+
+	void write(uint64_t start, uint32_t count, float * const *inputs) {
+		if (start >= frames) return;
+		count = uint32_t(std::min<uint64_t>(count, frames - start));
+		unsigned char *out = file.data + 44 + start*channels*4;
+		for (uint32_t i = 0; i < count; ++i) {
+			for (uint32_t c = 0; c < channels; ++c) {
+				std::memcpy(out, inputs[c] + i, 4);
+				out += 4;
+			}
+		}
+	}
+
+	void close() {
+		file.close();
+	}
+
+private:
+	MappedFile file;
+
+	static void put16(unsigned char *b, uint16_t v) {
+		b[0] = uint8_t(v);
+		b[1] = uint8_t(v>>8);
+	}
+	static void put32(unsigned char *b, uint32_t v) {
+		for (int i = 0; i < 4; ++i) b[i] = uint8_t(v>>(8*i));
+	}
+};
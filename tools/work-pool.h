@@ -0,0 +1,90 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/* Runs `job(index)` for every index in `[0, count)`, across a number of threads, using work-stealing.
+
+Each worker starts with a contiguous share of the indices, and takes from the front of its own queue.  When that's empty, it steals from the back of the busiest other queue - so uneven jobs (e.g. files of very different lengths) still keep every core busy until the end.
+
+	WorkPool::run(files.size(), threads, [&](size_t index, size_t worker){...});
+
+The jobs are coarse (a whole file each), so each queue just has its own mutex.
+*/
+struct WorkPool {
+	using Job = std::function<void(size_t index, size_t worker)>;
+
+	static void run(size_t count, size_t threads, const Job &job) {
+		if (!threads) threads = defaultThreads();
+		threads = std::max<size_t>(1, std::min(threads, count));
+		WorkPool pool{count, threads};
+
+		std::vector<std::thread> workers;
+		for (size_t w = 1; w < threads; ++w) {
+			workers.emplace_back([&pool, &job, w](){
+				pool.work(w, job);
+			});
+		}
+		pool.work(0, job); // this thread is worker 0
+		for (auto &t : workers) t.join();
+	}
+
+	static size_t defaultThreads() {
+		return std::max<unsigned>(1, std::thread::hardware_concurrency());
+	}
+
+private:
+	struct Queue {
+		std::mutex mutex;
+		std::deque<size_t> indices;
+	};
+	std::vector<std::unique_ptr<Queue>> queues;
+
+	WorkPool(size_t count, size_t threads) {
+		for (size_t w = 0; w < threads; ++w) {
+			queues.emplace_back(new Queue);
+			for (size_t i = count*w/threads; i < count*(w + 1)/threads; ++i) queues.back()->indices.push_back(i);
+		}
+	}
+
+	void work(size_t worker, const Job &job) {
+		size_t index;
+		while (pop(worker, index) || steal(worker, index)) job(index, worker);
+	}
+	bool pop(size_t worker, size_t &index) {
+		auto &queue = *queues[worker];
+		std::lock_guard<std::mutex> guard{queue.mutex};
+		if (queue.indices.empty()) return false;
+		index = queue.indices.front();
+		queue.indices.pop_front();
+		return true;
+	}
+	bool steal(size_t worker, size_t &index) {
+		while (true) {
+			// Pick the victim with the most left (sizes are approximate, so re-check under the lock)
+			size_t victim = worker, most = 0;
+			for (size_t w = 0; w < queues.size(); ++w) {
+				if (w == worker) continue;
+				std::lock_guard<std::mutex> guard{queues[w]->mutex};
+				if (queues[w]->indices.size() > most) {
+					most = queues[w]->indices.size();
+					victim = w;
+				}
+			}
+			if (victim == worker) return false; // nothing left anywhere
+			auto &queue = *queues[victim];
+			std::lock_guard<std::mutex> guard{queue.mutex};
+			if (queue.indices.empty()) continue;
+			index = queue.indices.back();
+			queue.indices.pop_back();
+			return true;
+		}
+	}
+};